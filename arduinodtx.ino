@@ -14,6 +14,16 @@ When changes were done I also changed the header information.
  ** Last change:
  ** 2015-10-09: changed misc. defs to allow for compilation w/ Arduino IDE 1.6.x
  ** 2015-10-15: corrected miniSSC channel value calculation in transmitter.cpp
+ ** 2026-10-16: analog inputs sampled in background by the ADC scanner
+ ** 2026-10-16: miniSSC packets queued for the interrupt-driven transmitter instead of SoftwareSerial
+ ** 2026-10-16: channel updates sent by the output scheduler within the link budget
+ ** 2026-10-16: SSC baud rate selected by global var SBR
+ ** 2026-10-16: output protocol selected by OUTPUT_PROTOCOL: miniSSC II or Pololu compact protocol
+ ** 2026-10-16: Timer1 frame clock replaces TimerOne, optional PPM output in parallel with the serial output
+ ** 2026-10-16: frame overruns detected by the frame clock, see PRINT STATS
+ ** 2026-10-16: channel values of each frame published in a lock-free snapshot for the command mode
+ ** 2026-10-16: telemetry records of the STREAM command sent by loop()
+ ** 2026-10-16: raw inputs of each frame published in the snapshot for STREAM
  */
 
 /*
@@ -25,8 +35,6 @@ When changes were done I also changed the header information.
 ** Resources -----------------------------------------------
 */
 
-#include <TimerOne.h>
-#include <SoftwareSerial.h>
 
 #include <EEPROM.h>
 #include "arduinotx_lib.h"
@@ -34,6 +42,12 @@ When changes were done I also changed the header information.
 #include "arduinotx_led.h"
 #include "arduinotx_command.h"
 #include "arduinodtx_transmitter.h"
+#include "arduinotx_adc.h"
+#include "arduinotx_ssc.h"
+#include "arduinotx_output.h"
+#include "arduinotx_protocol.h"
+#include "arduinotx_ppm.h"
+#include "arduinotx_snapshot.h"
 #ifdef BUZZER_ENABLED
 #include "arduinotx_buzz.h"
 #endif
@@ -54,31 +68,49 @@ ArduinotxEeprom Eeprom_obj;
 // Led manager
 ArduinotxLed Led_obj(LED_PIN);
 
+// ADC scanner
+ArduinotxAdc Adc_obj;
+
 #ifdef BUZZER_ENABLED
 // Buzzer manager
 ArduinotxBuzz Buzzer_obj(BUZZER_PIN);
 #endif
 
 // Serial Interface to SSC
-SoftwareSerial mySerial = SoftwareSerial(rx_PIN, tx_PIN);
+ArduinotxSsc Ssc_obj;
+
+// Output protocol
+#if OUTPUT_PROTOCOL == OUTPUT_PROTOCOL_POLOLU
+ArduinotxPololu Protocol_obj;
+#else
+ArduinotxMiniSsc Protocol_obj;
+#endif
+
+// Output scheduler
+ArduinotxOutput Output_obj(&Protocol_obj);
+
+// Frame clock and PPM generator
+ArduinotxPpm Ppm_obj;
 
-// These 2 global variables are used to request the PPM signal values from ISR(TIMER1_COMPA_vect)
-volatile byte RequestPpmCopy_bool = false;
-volatile unsigned int PpmCopy_int[CHANNELS]; // pulse widths (microseconds)
+// Channel values of the last frame, published by callback()
+ArduinotxSnapshot Snapshot_obj;
 
 /*
 ** Arduino specific functions -----------------------------------------------------------------
 */
 
 void setup() {
-	ArduinoTx_obj.Init();
+	// start the background conversions of the analog inputs
+	Adc_obj.Init();
+
+        // initialize serial communication to SSC, ArduinoTx_obj.Init() switches to the baud rate defined by global var SBR
+        Ssc_obj.Init(tx_PIN, SSC_BAUDRATE);
+        Output_obj.Init(SSC_BAUDRATE);
 
-        // initialize serial communication to SSC
-        mySerial.begin(9600);       
+	ArduinoTx_obj.Init();
 
 	// configure Timer1 for update cycle
-        Timer1.initialize(cUpdateCycle);
-        Timer1.attachInterrupt(callback);  // attaches callback() as a timer overflow interrupt	
+        Ppm_obj.Init(callback);  // callback() is called by ISR(TIMER1_COMPA_vect) every cUpdateCycle microseconds
 }
 
 /* serialEvent() occurs whenever a new data comes in the hardware serial RX. 
@@ -92,34 +124,35 @@ void serialEvent() {
 
 //~ volatile unsigned int DebugValue_int = 0; // debug
 
-// Scan all channels for actual values and transmit changed values using the miniSSCII-protocol
+// Scan all channels for actual values and transmit changed values using the protocol selected by OUTPUT_PROTOCOL
+// the output scheduler chooses which changed values fit in the link budget of this frame
 // Warning: calling Serial.print() within this method will probably hang the program
+// The packets are only queued here, they are sent by ISR(TIMER2_COMPA_vect), see arduinotx_ssc.cpp
 
 void callback() {
-	static byte Chan_idx_byt = CHANNELS;
-	static unsigned int Chan_pulse_int[CHANNELS]; // pulse widths (microseconds)
-	static unsigned int Sum_int = 0;
-	// Read input controls and update Chan_pulse_int[]
+	// the frame clock does not call callback() again before it returns, see ArduinotxPpm::Frame()
+	// let the SSC bit clock, millis() and the Serial interrupts run while the frame is computed
+	interrupts();
+	// Sample each physical input once for all channels and mixers
+	unsigned int pots_int[NPOTS];
+	byte switches_byt = ArduinoTx_obj.SampleInputs(pots_int);
+	// Read input controls and compute the channel pulses
+	unsigned int pulses_int[CHANNELS]; // quarter microseconds
+	unsigned int inputs_int[CHANNELS];
 	for (byte chan_byt = 0; chan_byt < CHANNELS; chan_byt++) {
 		unsigned int control_value_int = 0;
-		unsigned int ChanMin_int, ChanMax_int;
-		control_value_int = ArduinoTx_obj.ComputeChannelPulse(chan_byt, ArduinoTx_obj.ReadControl(chan_byt));
-    if (control_value_int != Chan_pulse_int[chan_byt]) {
-      mySerial.write(byte(0xFF));  // synch token
-      mySerial.write(chan_byt);    // channel _PWL
-      mySerial.write(byte(control_value_int));
-		  Chan_pulse_int[chan_byt] = control_value_int;
-    }
-	}
-	if (RequestPpmCopy_bool) {
-		// copy the PPM sequence values into global array for the "print ppm" command
-		for (byte chan_byt = 0; chan_byt < CHANNELS; chan_byt++)
-			PpmCopy_int[chan_byt] = Chan_pulse_int[chan_byt] ;
-		RequestPpmCopy_bool = false;
+		inputs_int[chan_byt] = ArduinoTx_obj.ReadControl(chan_byt);
+		control_value_int = ArduinoTx_obj.ComputeChannelPulse(chan_byt, inputs_int[chan_byt]);
+		Output_obj.Update(chan_byt, control_value_int, ArduinoTx_obj.GetChannelPriority(chan_byt));
+		pulses_int[chan_byt] = control_value_int;
 	}
+	Output_obj.Send();
+	Ppm_obj.Set(pulses_int); // does nothing if PPM_ENABLED is not defined
+	Snapshot_obj.Publish(pulses_int, inputs_int, pots_int, switches_byt); // for the "print ppm" and "stream" commands
+	noInterrupts();
 }
 
-// The main loop is interrupted every PPM_PERIOD ms by ISR(TIMER1_COMPA_vect)
+// The main loop is interrupted every cUpdateCycle microseconds by ISR(TIMER1_COMPA_vect)
 // we perform non time-critical operations in here
 void loop() {
 	// TXREFRESH_PERIOD defines the frequency at which Special Switches are read and corresponding transmitter state is updated
@@ -132,6 +165,7 @@ void loop() {
 	}
 	
 	Led_obj.Refresh();
+	Command_obj.Refresh(); // telemetry records, see STREAM
 #ifdef BUZZER_ENABLED	
 	Buzzer_obj.Refresh();
 #endif
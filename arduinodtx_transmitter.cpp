@@ -19,6 +19,22 @@
 ** 29-05-2014 ReadBattery()
 ** 30-05-2014 changed Endpoints semantics: now EPL,EPH: [0,100] defines end point position in % from the center
 ** 01-06-2014 fixed cond compil of ReadBattery()
+** 16-10-2026 ComputeChannelPulse() fixed-point exponential curves and end points, no more float code in the frame ISR
+** 16-10-2026 load_settings() compiles the transfer plan of each channel, compile_channel(), run_plan()
+** 16-10-2026 analog inputs are read from the background ADC scanner instead of analogRead()
+** 16-10-2026 SampleInputs() samples and calibrates each physical input once per frame for ReadControl()
+** 16-10-2026 GetChannelPriority() for the output scheduler
+** 16-10-2026 apply_link_settings() sets the SSC baud rate from global var SBR
+** 16-10-2026 ComputeChannelPulse() returns quarter microseconds, quantized by the output protocol
+** 16-10-2026 compile_channel() maps to the pulse range [PWL, PWH] of each channel
+** 16-10-2026 PPM_PIN restored for the Timer1 PPM generator
+** 16-10-2026 load_settings() restores the defaults of a block with a checksum error and raises ALARM_EEPROM
+** 16-10-2026 compile_channel(): signed dual rate slope, DUA=0 keeps the channel centered
+** 16-10-2026 load_settings() loads the dataset in a local copy, Dataset_obj is updated with interrupts disabled
+** 16-10-2026 SampleInputs() returns the raw potentiometer values and the state of all switches for the snapshot of the frame
+** 16-10-2026 dual rate computed within 32-bit long, checked at compile time for each DUA and input value
+** 16-10-2026 load_settings() loads the global variables in a local copy too, an invalid dataset number selects dataset 1
+** 16-10-2026 pulse range computed by pulse_slope(), pulse_base() and pulse_width(), checked at compile time with int32_t
 **
 Copyright (C) 2014 Richard Goutorbe.  All right reserved.
 This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
@@ -27,8 +43,6 @@ See the GNU General Public License for more details. You should have received a
 Contact information: http://www.reseau.org/arduinorc/index.php?n=Main.Contact
 */
 
-#include "TimerOne.h"
-
 #include "arduinodtx_transmitter.h"
 #include "arduinotx_led.h"
 #include "arduinotx_command.h"
@@ -36,9 +50,14 @@ Contact information: http://www.reseau.org/arduinorc/index.php?n=Main.Contact
 #include "arduinotx_buzz.h"
 #endif
 #include "arduinotx_lib.h"
+#include "arduinotx_expo.h"
+#include "arduinotx_adc.h"
+#include "arduinotx_output.h"
+#include "arduinotx_ssc.h"
 
 // PPM signal -----------------------------------------------------------------
 
+const byte ArduinoTx::PPM_PIN = 10; // OC1B
 #if CHANNELS <= 6
 const unsigned int ArduinoTx::PPM_PERIOD = 20000;	// microseconds; send PPM sequence every 20ms for 6 channels
 const unsigned int ArduinoTx::PPM_LOW = 400;		// microseconds; fixed channel sync pulse width in the PPM signal
@@ -69,6 +88,12 @@ extern ArduinotxLed Led_obj;
 // Buzzer manager
 extern ArduinotxBuzz Buzzer_obj;
 #endif
+// ADC scanner
+extern ArduinotxAdc Adc_obj;
+// miniSSC transmitter
+extern ArduinotxSsc Ssc_obj;
+// Output scheduler
+extern ArduinotxOutput Output_obj;
 /*
 ** Public interface ------------------------------------------------------------
 */
@@ -99,6 +124,9 @@ void ArduinoTx::Init() {
 #endif
 			case LED_PIN:
 			case tx_PIN:
+#ifdef PPM_ENABLED
+			case PPM_PIN:
+#endif
 				pinMode(idx_byt, OUTPUT);
 				break;
 			
@@ -135,9 +163,9 @@ void ArduinoTx::Init() {
 #endif
 	
 	if (Eeprom_obj.CheckEEProm() > 0) {
-		load_settings();
-		SettingsLoaded_bool = true;
 		TxAlarm_int = ALARM_NONE;
+		load_settings(); // raises ALARM_EEPROM if a block has been restored
+		SettingsLoaded_bool = true;
 	}
 	else {
 		SettingsLoaded_bool = false;
@@ -199,35 +227,56 @@ void ArduinoTx::Refresh() {
 	
 }
 
+// Sample all physical inputs, called once per frame by callback() before ReadControl()
+// each potentiometer used by the current model is calibrated once, no matter how many channels and mixers read it
+// out_pots_int: raw value of each potentiometer [0, 1023]
+// Return value: state of each switch, bit 0 = switch 1, 1=HIGH
+byte ArduinoTx::SampleInputs(unsigned int out_pots_int[]) {
+	unsigned int samples_int[ADC_INPUTS];
+	Adc_obj.Snapshot(samples_int);
+	for (byte idx_byt = 0; idx_byt < NPOTS; idx_byt++) {
+		out_pots_int[idx_byt] = samples_int[ADC_POT(idx_byt + 1)];
+		if (PotsUsed_byt & (1 << idx_byt))
+			Inputs_int[idx_byt] = calibrate_potentiometer(idx_byt + 1, out_pots_int[idx_byt]);
+	}
+	byte switches_byt = 0;
+	for (byte idx_byt = 0; idx_byt < NSWITCHES; idx_byt++) {
+		if (digitalRead(get_switch_pin(idx_byt + 1)) == HIGH)
+			switches_byt |= 1 << idx_byt;
+	}
+	Switches_byt = switches_byt;
+	return switches_byt;
+}
+
 // Read the input control corresponding to given channel, using the array of assignement of potentiometers and switches
 // chan_byt : 0-based, channel number - 1
 // Return value: calibrated value [0, 1023]
-// It takes about 100 microseconds to read an analog input
+// Inputs are read from the samples of the current frame, see SampleInputs()
 unsigned int ArduinoTx::ReadControl(byte chan_byt) {
 	unsigned int retval_int = 0;
-	byte ctrl_type_byt = get_channel_var(chan_byt, CHAN_ICT);
-	byte ctrl_number_byt = get_channel_var(chan_byt, CHAN_ICN);
+	byte ctrl_type_byt = get_channel(chan_byt)->Ict_byt;
+	byte ctrl_number_byt = get_channel(chan_byt)->Icn_byt;
 	switch (ctrl_type_byt) {
 		case ICT_ANALOG: 
 			if (ctrl_number_byt > 0 && ctrl_number_byt <= NPOTS)
-				retval_int = read_potentiometer(ctrl_number_byt);
+				retval_int = get_input(ctrl_number_byt);
 			break;
 		case ICT_DIGITAL:
 			if (ctrl_number_byt > 0 && ctrl_number_byt <= NSWITCHES)
-				retval_int = digitalRead(get_switch_pin(ctrl_number_byt)) == HIGH ? 1023: 0; // switch
+				retval_int = (Switches_byt & (1 << (ctrl_number_byt - 1))) ? 1023: 0; // switch
 			break;
 		case ICT_MIXER: {
 			long value_lng = 0L;
 			byte pot_number_byt = 0;
-			--ctrl_number_byt; // get_mixer_var() expects a 0-based mixer index
+			--ctrl_number_byt; // get_mixer() expects a 0-based mixer index
 			// mixer input 1
-			pot_number_byt = get_mixer_var(ctrl_number_byt, MIX_N1M);
+			pot_number_byt = get_mixer(ctrl_number_byt)->N1m_byt;
 			if (pot_number_byt > 0 && pot_number_byt <= NPOTS)
-				value_lng = (read_potentiometer(pot_number_byt) - 512L) * get_mixer_var(ctrl_number_byt, MIX_P1M);
+				value_lng = (get_input(pot_number_byt) - 512L) * get_mixer(ctrl_number_byt)->P1m_chr;
 			// mixer input 2
-			pot_number_byt = get_mixer_var(ctrl_number_byt, MIX_N2M);
+			pot_number_byt = get_mixer(ctrl_number_byt)->N2m_byt;
 			if (pot_number_byt > 0 && pot_number_byt <= NPOTS)
-				value_lng += (read_potentiometer(pot_number_byt) - 512L) * get_mixer_var(ctrl_number_byt, MIX_P2M);
+				value_lng += (get_input(pot_number_byt) - 512L) * get_mixer(ctrl_number_byt)->P2m_chr;
 			// resulting value
 			retval_int = constrain(512L + (value_lng / 100L), 0, 1023);
 			}
@@ -242,122 +291,299 @@ unsigned int ArduinoTx::ReadControl(byte chan_byt) {
 // Compute the channel pulse corresponding to given analog value
 // chan_byt : 0-based, channel number - 1
 // ana_value_int : read from input: [0,1023]
-// Return value: PWM pulse width, microseconds
+// Return value: pulse width in quarter microseconds
+// The transfer plan of the channel has been compiled by load_settings(), see compile_channel()
 // Warning: calling Serial.print() within this method will probably hang the program, a safer way is to display global var DebugValue_int in loop() :
 //~ extern unsigned int DebugValue_int;
 unsigned int ArduinoTx::ComputeChannelPulse(byte chan_byt, unsigned int ana_value_int) {
 	unsigned int retval_int = 0;
-	unsigned int value_int = ana_value_int;
-  
-	byte throttle_channel_byt = get_model_var(MOD_THC) - 1; // 0-based throttle chan number
-	if (ThrottleCut_bool || !EngineEnabled_bool)
-		if (chan_byt == throttle_channel_byt)
-			value_int = 0; // cut throttle
+	const ChannelPlan *plan_ptr = &ChannelPlans_obj[chan_byt];
+	if (plan_ptr->Throttle_bool && (ThrottleCut_bool || !EngineEnabled_bool))
+		retval_int = plan_ptr->CutPulse_int[DualRate_bool ? 1:0]; // cut throttle
+	else
+		retval_int = run_plan(plan_ptr, ana_value_int, DualRate_bool);
+	return retval_int;
+}
+
+// Return the output priority of given channel, see arduinotx_output.h
+byte ArduinoTx::GetChannelPriority(byte chan_byt) {
+	return ChannelPlans_obj[chan_byt].Priority_byt;
+}
+
+/*
+** Private Implementation ------------------------------------------------------------
+*/
+
+// load settings values from EEPROM
+// updates CurrentDataset_byt
+// Only the global variables and the current dataset are checked: a block with a checksum error is set to its default values,
+// the other blocks are left unchanged. An invalid dataset number selects dataset 1.
+// The blocks are loaded in local copies: the calibration and the mixer values are read in the frame ISR
+void ArduinoTx::load_settings() {
+	GlobalSettings global_obj;
+	if (Eeprom_obj.GetGlobal(&global_obj) != 0) { // load values of GLOBAL_CDS and GLOBAL_ADS
+		Eeprom_obj.InitBlock(0);
+		Eeprom_obj.GetGlobal(&global_obj);
+		TxAlarm_int = ALARM_EEPROM; // clear by Reset of Arduino board
+	}
+	noInterrupts();
+	Global_obj = global_obj;
+	interrupts();
 	
-// Dual rate and Exponential
-  if (DualRate_bool) {
-    // apply exponential
-		byte expo_byt = get_channel_var(chan_byt, CHAN_EXP); // 0=none, 25=medium, 50=strong 100=too much
-		if (expo_byt != 0) {
-      // apply full exponential curve to the throttle channel (contributed by jbjb)			
-      float expoval_flt = expo_byt / 10.0;
-			if (chan_byt == throttle_channel_byt) {
-        float value_flt = value_int / 1023.0; // map to [0, +1] range
-        value_flt = value_flt * exp(abs(expoval_flt * value_flt)) / exp(expoval_flt);
-        value_int = (unsigned int)(1023 * value_flt); // map to [0, 1023] range
-      }
-      else {
-        // apply centered symetrical curve to other channels
-        float value_flt = 2.0 * ((value_int / 1023.0) - 0.5); // map to [-1, +1] range
-        value_flt = value_flt * exp(abs(expoval_flt * value_flt)) / exp(expoval_flt);
-        value_int = 512 + (unsigned int)(511.5 * value_flt); // map to [0, 1023] range
-      }
-		}
-		else {
-			// apply dual rate if no exponential for this channel
-			unsigned int offset_int = get_channel_var(chan_byt, CHAN_DUA);
-			if (offset_int != 100) {
-				offset_int = offset_int << 9; // multiply by 512, max value = 100*512 = 51200
-        value_int = (unsigned int)(map(value_int, 0, 1023, 51200 - offset_int, 51100 + offset_int) / 100);			}
+	CurrentDataset_byt = get_selected_dataset(); // Dataset (model number) currently loaded in RAM
+	if (CurrentDataset_byt == 0 || CurrentDataset_byt > NDATASETS) {
+		// GetDataset() would not load anything
+		CurrentDataset_byt = 1;
+		TxAlarm_int = ALARM_EEPROM;
+	}
+	DatasetSettings dataset_obj;
+	if (Eeprom_obj.GetDataset(CurrentDataset_byt, &dataset_obj) != 0) {
+		Eeprom_obj.InitBlock(CurrentDataset_byt);
+		Eeprom_obj.GetDataset(CurrentDataset_byt, &dataset_obj);
+		TxAlarm_int = ALARM_EEPROM;
+	}
+	noInterrupts();
+	Dataset_obj = dataset_obj;
+	interrupts();
+	
+	// SSC baud rate
+	apply_link_settings();
+	
+	// select the physical inputs sampled by SampleInputs()
+	compile_inputs();
+	
+	// compile the transfer plan of each channel
+	for (byte chan_byt = 0; chan_byt < CHANNELS; chan_byt++) {
+		ChannelPlan plan_obj;
+		compile_channel(chan_byt, &plan_obj);
+		noInterrupts(); // ChannelPlans_obj[] is read by ComputeChannelPulse() in the frame ISR
+		ChannelPlans_obj[chan_byt] = plan_obj;
+		interrupts();
+	}
+}
+
+// Restart the SSC link if global variable SBR has changed
+void ArduinoTx::apply_link_settings() {
+	unsigned long baudrate_lng = Global_obj.Sbr_int * 100UL;
+	if (baudrate_lng < 2400UL || baudrate_lng > 115200UL)
+		baudrate_lng = SSC_BAUDRATE; // not validated by ArduinotxEeprom::Validate(), e.g. uploaded by an older txupload
+	if (baudrate_lng != Ssc_obj.GetBaudrate()) {
+		noInterrupts(); // the frame ISR writes into both
+		Ssc_obj.Init(tx_PIN, baudrate_lng);
+		Output_obj.Init(baudrate_lng); // the receiver gets a keyframe at the new baud rate
+		interrupts();
+	}
+}
+
+// Find the potentiometers used by the channels and mixers of the current model, compute their calibration
+void ArduinoTx::compile_inputs() {
+	byte pots_used_byt = 0;
+	for (byte chan_byt = 0; chan_byt < CHANNELS; chan_byt++) {
+		byte ctrl_number_byt = get_channel(chan_byt)->Icn_byt;
+		switch (get_channel(chan_byt)->Ict_byt) {
+			case ICT_ANALOG:
+				if (ctrl_number_byt > 0 && ctrl_number_byt <= NPOTS)
+					pots_used_byt |= 1 << (ctrl_number_byt - 1);
+				break;
+			case ICT_MIXER:
+				if (ctrl_number_byt > 0 && ctrl_number_byt <= NMIXERS) {
+					byte pot_number_byt = get_mixer(ctrl_number_byt - 1)->N1m_byt;
+					if (pot_number_byt > 0 && pot_number_byt <= NPOTS)
+						pots_used_byt |= 1 << (pot_number_byt - 1);
+					pot_number_byt = get_mixer(ctrl_number_byt - 1)->N2m_byt;
+					if (pot_number_byt > 0 && pot_number_byt <= NPOTS)
+						pots_used_byt |= 1 << (pot_number_byt - 1);
+				}
+				break;
 		}
 	}
 	
-	// apply subtrim
-	int trim_int = get_channel_var(chan_byt, CHAN_SUB);
-	if (trim_int) {
-		// approximate 1024/100 = 10.24 ~ 10
-		value_int += 10 * trim_int;
-		if (value_int > 32767)
-			value_int = 0L; // underflow
-		else if (value_int > 1023)
-			value_int = 1023;
+	noInterrupts(); // these values are read by SampleInputs() in the frame ISR
+	for (byte pot_number_byt = 1; pot_number_byt <= NPOTS; pot_number_byt++) {
+		// map(raw, KLn, KHn, 0, 1023) = (raw - KLn) * CalScale_lng[n-1] >> 16
+		// rounded up so that the highest value KHn still gives 1023
+		long range_lng = (long)get_calibration(pot_number_byt, CAL_HIGH) - get_calibration(pot_number_byt, CAL_LOW);
+		CalScale_lng[pot_number_byt - 1] = range_lng > 0 ? ((1023UL << 16) + range_lng - 1) / range_lng : 0UL;
 	}
+	PotsUsed_byt = pots_used_byt;
+	unsigned int pots_int[NPOTS];
+	SampleInputs(pots_int); // ReadControl() is valid before the next frame, e.g. for check_throttle()
+	interrupts();
+}
+
+// Dual rate: value = map(value, 0, 1023, 51200 - offset, 51100 + offset) / 100, where offset = DUA * 512
+// computed as (base + value * scale) >> 16 with int32_t, as long on the ATmega328:
+// base = (51200 - offset) / 100 * 65536 = (51200 - offset) * 16384 / 25, [0, 33554432]
+// scale = (2 * offset - 100) / 102300 * 65536 = (2 * offset - 100) * 16384 / 25575, [-64, 65536], negative if DUA=0
+// the intermediate products stay below 2^31 for DUA <= 100
+static constexpr int32_t dual_rate_base(byte dualrate_byt) {
+	return ((int32_t)51200 - (int32_t)dualrate_byt * 512) * 16384 / 25;
+}
+static constexpr int32_t dual_rate_scale(byte dualrate_byt) {
+	return ((int32_t)dualrate_byt * 1024 - 100) * 16384 / 25575;
+}
+static constexpr unsigned int dual_rate(int32_t base_lng, int32_t scale_lng, unsigned int value_int) {
+	return (base_lng + (int32_t)value_int * scale_lng + (int32_t)32768) >> 16;
+}
+
+// The int32_t overflows of a constant expression are compile errors: check each DUA and input value against map()
+static constexpr int32_t dual_rate_map(byte dualrate_byt, unsigned int value_int) {
+	return ((int32_t)51200 - (int32_t)dualrate_byt * 512 + (int32_t)value_int * ((int32_t)dualrate_byt * 1024 - 100) / 1023) / 100;
+}
+static constexpr int32_t dual_rate_error(byte dualrate_byt, unsigned int value_int) {
+	return (int32_t)dual_rate(dual_rate_base(dualrate_byt), dual_rate_scale(dualrate_byt), value_int) - dual_rate_map(dualrate_byt, value_int);
+}
+static constexpr bool dual_rate_valid(byte dualrate_byt, unsigned int first_int, unsigned int last_int) {
+	return first_int == last_int
+		? dual_rate_error(dualrate_byt, first_int) >= -1 && dual_rate_error(dualrate_byt, first_int) <= 1
+			&& dual_rate(dual_rate_base(dualrate_byt), dual_rate_scale(dualrate_byt), first_int) <= 1023
+		: dual_rate_valid(dualrate_byt, first_int, (first_int + last_int) / 2) && dual_rate_valid(dualrate_byt, (first_int + last_int) / 2 + 1, last_int);
+}
+static constexpr bool dual_rates_valid(byte first_byt, byte last_byt) {
+	return first_byt == last_byt ? dual_rate_valid(first_byt, 0, 1023)
+		: dual_rates_valid(first_byt, (first_byt + last_byt) / 2) && dual_rates_valid((first_byt + last_byt) / 2 + 1, last_byt);
+}
+static_assert(dual_rates_valid(0, 100), "dual rate out of the range of map() or overflow of int32_t");
+static_assert(dual_rate(dual_rate_base(0), dual_rate_scale(0), 0) == 512 && dual_rate(dual_rate_base(0), dual_rate_scale(0), 1023) == 511, "DUA=0 must keep the channel centered");
+
+// Pulse range: pulse = (base + value * slope) >> 16 with int32_t, value [0, 1023], pulse in quarter microseconds
+// slope of map(value, 0, 1023, low, high), 65536=1
+static constexpr int32_t pulse_slope(int low_int, int high_int) {
+	return (int32_t)(high_int - low_int) * 65536 / 1023;
+}
+static constexpr int32_t pulse_base(int low_int) {
+	return (int32_t)low_int * 65536 + 32768;
+}
+static constexpr unsigned int pulse_width(int32_t base_lng, int32_t slope_lng, int value_int) {
+	return (base_lng + value_int * slope_lng) >> 16;
+}
+
+// The widest pulse range [4 * PPM_LOW, 40 * PPM_LOW] quarter microseconds, in both directions, must not overflow int32_t;
+// the end points only narrow the range, see compile_channel()
+static_assert(pulse_width(pulse_base(4 * ArduinoTx::PPM_LOW), pulse_slope(4 * ArduinoTx::PPM_LOW, 40 * ArduinoTx::PPM_LOW), 1023) == 40 * ArduinoTx::PPM_LOW
+	&& pulse_width(pulse_base(40 * ArduinoTx::PPM_LOW), pulse_slope(40 * ArduinoTx::PPM_LOW, 4 * ArduinoTx::PPM_LOW), 1023) == 4 * ArduinoTx::PPM_LOW
+	&& pulse_width(pulse_base(40 * ArduinoTx::PPM_LOW), pulse_slope(40 * ArduinoTx::PPM_LOW, 4 * ArduinoTx::PPM_LOW), 0) == 40 * ArduinoTx::PPM_LOW,
+	"pulse range out of int32_t");
+
+// Compile the transfer plan of given channel from the channel variables
+// chan_byt : 0-based, channel number - 1
+// The plan applies, in this order:
+//	dual rate or exponential, only when the dual rate switch is ON
+//	subtrim
+//	end points
+//	reverse and mapping to the pulse range [PWL, PWH], in quarter microseconds
+void ArduinoTx::compile_channel(byte chan_byt, ChannelPlan *out_plan) {
+	byte throttle_channel_byt = Dataset_obj.Model_obj.Thc_byt - 1; // 0-based throttle chan number
+	out_plan->Throttle_bool = (chan_byt == throttle_channel_byt);
 	
-	//~ // debug: display value_int in loop()
-	//~ if (chan_byt == elevator_channel_byt)
-		//~ DebugValue_int = value_int;
+	// output priority: throttle first, switches last
+	byte ctrl_type_byt = get_channel(chan_byt)->Ict_byt;
+	if (out_plan->Throttle_bool)
+		out_plan->Priority_byt = OUTPUT_PRIORITY_HIGH;
+	else if (ctrl_type_byt == ICT_ANALOG || ctrl_type_byt == ICT_MIXER)
+		out_plan->Priority_byt = OUTPUT_PRIORITY_NORMAL;
+	else
+		out_plan->Priority_byt = OUTPUT_PRIORITY_LOW;
 	
-	// apply end points
-  // EPL,EPH: [0,100] end point position in % from the center, 
-  // examples: 10=10% from the center, 90=90% from the center (10% from the maximum throw), 100=maximum throw (no endpoint)
-  //
-#if ENDPOINTS_ALGORITHM == ENDPOINTS_LIMITED
-  // the control stick has 2 dead-angles corresponding to each endpoint. Moving the stick
-  // beyond this angle will have no effect on the PPM signal.
-  unsigned int endpoint_int = (unsigned int)(5.11 * (100 - get_channel_var(chan_byt, CHAN_EPL))); // EPL=80: 5.11 * 20 = 102.2
-	if (value_int < endpoint_int)
-		value_int = endpoint_int;
-	else {
-	  endpoint_int = 511 + (unsigned int)(5.12 * get_channel_var(chan_byt, CHAN_EPH)); // EPH=80: 511 + (5.12 * 80) = 920.6
-		if (value_int > endpoint_int)
-				value_int = endpoint_int;
+	// Dual rate and Exponential
+	out_plan->Rate_byt = RATE_NONE;
+	out_plan->RateScale_lng = 0L;
+	out_plan->RateBase_lng = 0L;
+	byte expo_byt = get_channel(chan_byt)->Exp_byt; // 0=none, 25=medium, 50=strong 100=too much
+	unsigned int dualrate_int = get_channel(chan_byt)->Dua_byt;
+	if (expo_byt != 0) {
+		// full exponential curve for the throttle channel (contributed by jbjb), centered symetrical curve for other channels
+		out_plan->Rate_byt = out_plan->Throttle_bool ? RATE_EXPO_FULL:RATE_EXPO;
+		out_plan->RateScale_lng = expoScale(expo_byt);
 	}
-#else
-  // ENDPOINTS_ALGORITHM == ENDPOINTS_BILINEAR
-  // the control stick has no dead-angles: moving it from min to max will output a PPM signal 
-  // within the endpoints interval. However, the variation rate of the signal in the lower half of
-  // the interval will not be the same as in the higher half if CHAN_EPL != CHAN_EPH.
-  // This may be acceptable or not.
-  unsigned int endpoint_int = 0;
-  if (value_int < 512) {
-    endpoint_int = (unsigned int)(5.11 * (100 - get_channel_var(chan_byt, CHAN_EPL)));
-    value_int = (unsigned int)map(value_int, 0, 511, endpoint_int, 511);
-  }
-  else {
-    endpoint_int = 512 + (5.12 * get_channel_var(chan_byt, CHAN_EPH));
-    if (endpoint_int == 1024)
-      endpoint_int = 1023;
-    value_int = (unsigned int)map(value_int, 512, 1023, 512, endpoint_int);
-  }
-#endif
-
-  // apply reverse
-	 
-  unsigned int low_int = 0; // Minimal value for miniSSC
-  unsigned int high_int = 254; // Maximal value for miniSSC
+	else if (dualrate_int != 100) {
+		// dual rate if no exponential for this channel, see dual_rate_base()
+		out_plan->Rate_byt = RATE_DUAL;
+		out_plan->RateBase_lng = dual_rate_base(dualrate_int);
+		out_plan->RateScale_lng = dual_rate_scale(dualrate_int);
+	}
+	
+	// subtrim
+	// approximate 1024/100 = 10.24 ~ 10
+	out_plan->Trim_int = 10 * get_channel(chan_byt)->Sub_chr;
 	
-	if (get_channel_var(chan_byt, CHAN_REV)) {
-		unsigned int tmp_int = low_int;
+	// reverse and pulse range, quarter microseconds
+	// PWL, PWH: [PPM_LOW, 10 * PPM_LOW] microseconds, see ArduinotxEeprom::Validate()
+	int low_int = 4 * get_channel(chan_byt)->Pwl_int;
+	int high_int = 4 * get_channel(chan_byt)->Pwh_int;
+	if (get_channel(chan_byt)->Rev_byt) {
+		int swap_int = low_int;
 		low_int = high_int;
-		high_int = tmp_int;
+		high_int = swap_int;
 	}
+	long slope_lng = pulse_slope(low_int, high_int);
 	
-  // Map value into miniSSC range
-  retval_int =  map(value_int, 0, 1023, low_int, high_int);
+	// end points
+	// EPL,EPH: [0,100] end point position in % from the center, 
+	// examples: 10=10% from the center, 90=90% from the center (10% from the maximum throw), 100=maximum throw (no endpoint)
+	//
+#if ENDPOINTS_ALGORITHM == ENDPOINTS_LIMITED
+	// the control stick has 2 dead-angles corresponding to each endpoint. Moving the stick
+	// beyond this angle will have no effect on the PPM signal.
+	out_plan->Low_int = (511U * (100 - get_channel(chan_byt)->Epl_byt)) / 100; // EPL=80: 5.11 * 20 = 102.2
+	out_plan->High_int = min(1023, 511 + (512U * get_channel(chan_byt)->Eph_byt) / 100); // EPH=80: 511 + (5.12 * 80) = 920.6
+	for (byte s_byt = 0; s_byt < 2; s_byt++) {
+		out_plan->Slope_lng[s_byt] = slope_lng;
+		out_plan->Base_lng[s_byt] = pulse_base(low_int);
+	}
+#else
+	// ENDPOINTS_ALGORITHM == ENDPOINTS_BILINEAR
+	// the control stick has no dead-angles: moving it from min to max will output a PPM signal 
+	// within the endpoints interval. However, the variation rate of the signal in the lower half of
+	// the interval will not be the same as in the higher half if CHAN_EPL != CHAN_EPH.
+	// This may be acceptable or not.
+	out_plan->Low_int = 0;
+	out_plan->High_int = 1023;
+	// lower half: value = map(value, 0, 511, endpoint, 511)
+	int endpoint_int = (511U * (100 - get_channel(chan_byt)->Epl_byt)) / 100;
+	out_plan->Slope_lng[0] = (slope_lng * (511 - endpoint_int)) / 511;
+	out_plan->Base_lng[0] = pulse_base(low_int) + slope_lng * endpoint_int;
+	// higher half: value = map(value, 512, 1023, 512, endpoint)
+	endpoint_int = min(1023, 512 + (512U * get_channel(chan_byt)->Eph_byt) / 100);
+	out_plan->Slope_lng[1] = (slope_lng * (endpoint_int - 512)) / 511;
+	out_plan->Base_lng[1] = pulse_base(low_int) + 512 * (slope_lng - out_plan->Slope_lng[1]);
+#endif
 
- 	return retval_int;
+	// pulses sent while the throttle is cut: same plan applied to the lowest input value
+	out_plan->CutPulse_int[0] = run_plan(out_plan, 0, false);
+	out_plan->CutPulse_int[1] = run_plan(out_plan, 0, true);
 }
 
-/*
-** Private Implementation ------------------------------------------------------------
-*/
-
-// load settings values from EEPROM
-// updates CurrentDataset_byt
-void ArduinoTx::load_settings() {
-	Eeprom_obj.GetGlobal(Global_int); // load values of GLOBAL_CDS and GLOBAL_ADS
-	CurrentDataset_byt = get_selected_dataset(); // Dataset (model number) currently loaded in RAM
-	Eeprom_obj.GetDataset(CurrentDataset_byt, DatasetModel_int, DatasetMixers_int, DatasetChannels_int);
+// Execute the transfer plan of a channel
+// plan : compiled by compile_channel()
+// value_int : [0, 1023]
+// dualrate_bool : state of the dual rate switch
+// Return value: pulse width in quarter microseconds
+unsigned int ArduinoTx::run_plan(const ChannelPlan *plan, unsigned int value_int, byte dualrate_bool) {
+	// Dual rate and Exponential
+	if (dualrate_bool) {
+		switch (plan->Rate_byt) {
+			case RATE_DUAL:
+				value_int = dual_rate(plan->RateBase_lng, plan->RateScale_lng, value_int);
+				break;
+			case RATE_EXPO:
+				value_int = expoSymmetric(plan->RateScale_lng, value_int);
+				break;
+			case RATE_EXPO_FULL:
+				value_int = expoFull(plan->RateScale_lng, value_int);
+				break;
+		}
+	}
+	
+	// subtrim and end points
+	int trimmed_int = constrain((int)value_int + plan->Trim_int, plan->Low_int, plan->High_int);
+	
+	//~ // debug: display trimmed_int in loop()
+	//~ DebugValue_int = trimmed_int;
+	
+	// end points, reverse and pulse range
+	byte s_byt = trimmed_int < 512 ? 0:1;
+	return pulse_width(plan->Base_lng[s_byt], plan->Slope_lng[s_byt], trimmed_int);
 }
 
 // set RunMode according to switches settings
@@ -410,10 +636,10 @@ ArduinoTx::RunMode ArduinoTx::refresh_runmode() {
 // 0 if throttle is >= GLOBAL_TSC and sets ALARM_THROTTLE
 byte ArduinoTx::check_throttle() {
 	byte retval_byt = 1;
-	static unsigned int Average_int = 2 * get_global_var(GLOBAL_TSC); // average of last 8 analog readings
+	static unsigned int Average_int = 2 * Global_obj.Tsc_int; // average of last 8 analog readings
 	static byte Count_byt = 0;
 	int sample_int = 0;
-	byte throttle_chan_byt = get_model_var(MOD_THC);
+	byte throttle_chan_byt = Dataset_obj.Model_obj.Thc_byt;
 	if (throttle_chan_byt) {
 		do {
 			sample_int = ReadControl(throttle_chan_byt - 1);
@@ -424,7 +650,7 @@ byte ArduinoTx::check_throttle() {
 					Count_byt++;
 		} while (1);
 		
-		retval_byt = Average_int < (unsigned int)get_global_var(GLOBAL_TSC) ? 1:0;
+		retval_byt = Average_int < (unsigned int)Global_obj.Tsc_int ? 1:0;
 		if (retval_byt == 0)
 			TxAlarm_int = ALARM_THROTTLE; // Throttle security check has top priority: overwrite all other alarms
 		else if (TxAlarm_int == ALARM_THROTTLE)
@@ -439,11 +665,11 @@ byte ArduinoTx::check_throttle() {
 byte ArduinoTx::get_selected_dataset() {
   byte retval_byt = 0;
 #if MODEL_SWITCH_BEHAVIOUR == MODEL_SWITCH_SIMPLE
-  retval_byt = get_global_var(digitalRead(MODEL_SWITCH_PIN) ? GLOBAL_CDS:GLOBAL_ADS);
+  retval_byt = digitalRead(MODEL_SWITCH_PIN) ? Global_obj.Cds_byt : Global_obj.Ads_byt;
 #elif MODEL_SWITCH_BEHAVIOUR == MODEL_SWITCH_STEPPING
-  retval_byt = get_global_var(GLOBAL_CDS);
+  retval_byt = Global_obj.Cds_byt;
 #elif MODEL_SWITCH_BEHAVIOUR == MODEL_SWITCH_ROTATING
-  retval_byt = get_global_var(GLOBAL_CDS);
+  retval_byt = Global_obj.Cds_byt;
 #endif
   return retval_byt;
 }
@@ -499,7 +725,7 @@ byte ArduinoTx::debounce_rotating_switch() {
   const unsigned int step_int = 1024 / MODEL_ROTATING_SWITCH_STEPS;
   const unsigned int offset_int = step_int / 2;
   unsigned int limit_int = offset_int;
-  unsigned int sample_int = analogRead(MODEL_ROTATING_SWITCH_PIN) & 0xFFF8; // filter noise: ignore least significant 3 bits
+  unsigned int sample_int = Adc_obj.Read(ADC_MODEL_SWITCH) & 0xFFF8; // filter noise: ignore least significant 3 bits
   while (sample_int > limit_int) {
     position_int++;
     limit_int += step_int;
@@ -581,7 +807,7 @@ void ArduinoTx::refresh_led_code() {
 // 1 if voltage is > GLOBAL_BAT
 // 0 if throttle is <= GLOBAL_BAT and sets ALARM_BATTERY
 byte ArduinoTx::check_battery() {
-byte retval_byt = ReadBattery() > (unsigned int)get_global_var(GLOBAL_BAT) ? 1:0;
+byte retval_byt = ReadBattery() > (unsigned int)Global_obj.Bat_int ? 1:0;
   if (retval_byt == 0) {
     if (TxAlarm_int == ALARM_NONE)
       TxAlarm_int = ALARM_BATTERY;
@@ -591,26 +817,10 @@ byte retval_byt = ReadBattery() > (unsigned int)get_global_var(GLOBAL_BAT) ? 1:0
   return retval_byt;
 }
 
-// Read the battery voltage, averaged over several measurements
+// Read the battery voltage, averaged by the ADC scanner over the last 8 sweeps
 // Return value: [0, 1023] ; since we sample the voltage through a 50/50 resistor bridge we return 1023 for 10V, i.e.  102 for 1V
 unsigned int ArduinoTx::ReadBattery() {
-  unsigned int retval_int = 2 * get_global_var(GLOBAL_BAT); // average of last 8 analog readings
-  byte count_byt = 0;
-  int last_sample_int = 0;
-	int sample_int = 0;
-	do {
-		sample_int = analogRead(BATCHECK_PIN);
-    if (sample_int >=  last_sample_int >> 1) {
-      retval_int = (7 * retval_int + sample_int) >> 3; // >>3 divides by 8
-      last_sample_int = sample_int;
-		}
-		else {
-			// False readings happen once in a while, may be due to analogRead() being interrupted by ISR1 ?
-			//~ aprintfln("check_battery() ignore %d", sample_int);
-			sample_int =  last_sample_int; // ignore invalid sample
-		}
-    count_byt++;
-  } while (count_byt < 30);
+  unsigned int retval_int = Adc_obj.Read(ADC_BATTERY);
   retval_int += BATVOLT_CORRECTION; // see arduinotx_config.h
   return retval_int;
 }
@@ -618,12 +828,19 @@ unsigned int ArduinoTx::ReadBattery() {
 
 
 // Return calibrated value of given potentiometer
-unsigned int ArduinoTx::read_potentiometer(byte pot_number_byt) {
-	unsigned int retval_int = 0;
-	unsigned int chan_cal_int = get_calibration_var(pot_number_byt, CAL_LOW); // lowest value returned by the potentiometer corresponding to given channel
-	unsigned int chan_cah_int = get_calibration_var(pot_number_byt, CAL_HIGH); // highest value returned by the potentiometer corresponding to given channel
-	retval_int = analogRead(get_pot_pin(pot_number_byt));
-	retval_int = constrain(retval_int, chan_cal_int, chan_cah_int);
-	retval_int = map(retval_int, chan_cal_int, chan_cah_int, 0, 1023);
+// raw_int : value read on the potentiometer's input, [0, 1023]
+unsigned int ArduinoTx::calibrate_potentiometer(byte pot_number_byt, unsigned int raw_int) {
+	unsigned int chan_cal_int = get_calibration(pot_number_byt, CAL_LOW); // lowest value returned by the potentiometer corresponding to given channel
+	unsigned int chan_cah_int = get_calibration(pot_number_byt, CAL_HIGH); // highest value returned by the potentiometer corresponding to given channel
+	unsigned int retval_int = constrain(raw_int, chan_cal_int, chan_cah_int);
+	return ((retval_int - chan_cal_int) * CalScale_lng[pot_number_byt - 1]) >> 16;
+}
+
+// Return the calibrated value of given potentiometer sampled by SampleInputs()
+unsigned int ArduinoTx::get_input(byte pot_number_byt) {
+	byte sreg_byt = SREG;
+	cli(); // Inputs_int[] is refreshed in the frame ISR
+	unsigned int retval_int = Inputs_int[pot_number_byt - 1];
+	SREG = sreg_byt;
 	return retval_int;
 }
@@ -1,6 +1,9 @@
 /* arduinotx_transmitter.h - Tx manager
  
 ** 01-11-2016 merged latest version of arduinotx (1.5.5) into arduinodtx
+** 16-10-2026 Global_obj and Dataset_obj packed like the EEProm, get_mixer(), get_channel() and get_calibration() replace the get_*_var() macros
+** 16-10-2026 SampleInputs() returns the raw inputs of the frame
+** 16-10-2026 ChannelPlan::RateScale_lng
 
 
 Copyright (C) 2014-16 Gregor Schlechtriem.  All rights reserved.
@@ -23,31 +26,15 @@ The init process has been revised since the ppm signal is replaced by the miniSS
 
 // pin definition for serial communication to SSC
 #define tx_PIN 6	    // output pin to communicate to SSC
-#define rx_PIN 5      // dummy definition - currently not needed
+
+// baud rate of the serial link to the SSC until the settings are loaded, see global variable SBR
+#define SSC_BAUDRATE 9600
 
 // update cycle definition
 #define cUpdateCycle 20000  // 20 ms
 
 // Misc macros --------------------------------------------------------------------------
 
-// Access the value of given global variable
-// notice: symbolic names GLOBAL_* are defined in arduinotx_eeprom.h for the variables indexes
-#define get_global_var(idxvar) (Global_int[idxvar])
-
-// Access the value of given model variable
-// notice: symbolic names MOD_* are defined in arduinotx_eeprom.h for the variables indexes
-#define get_model_var(idxvar) (DatasetModel_int[idxvar])
-
-// Access the value of given variable in given mixer
-// notice: symbolic names MIX_* are defined in arduinotx_eeprom.h for the variables indexes
-// idxmixer : 0-based, mixer number - 1
-#define get_mixer_var(idxmixer, idxvar) (DatasetMixers_int[idxmixer][idxvar])
-
-// Access the value of given variable in given channel
-// notice: symbolic names CHAN_* are defined in arduinotx_eeprom.h for the variables indexes
-// idxchan : 0-based, channel number - 1
-#define get_channel_var(idxchan, idxvar) (DatasetChannels_int[idxchan][idxvar])
-
 // Assignement of potentiometers and switches
 // icn=control (potentiometer or switch) number defined in channel var ICN
 // value=corresponding Arduino's pin number:
@@ -57,11 +44,6 @@ The init process has been revised since the ppm signal is replaced by the miniSS
 #define get_pot_pin(icn) (icn - 1)
 #define get_switch_pin(icn) (icn + 1)
 
-// Access the calibration value for given potentiometer
-// icn=control (potentiometer) number defined in channel var ICN, 1-based
-// calvar calibration variable (CAL_LOW, CAL_HIGH)
-// return value: lowest/highest value returned by the potentiometer corresponding to given channel [0, 1023]
-#define get_calibration_var(icn, calvar) (get_global_var(((calvar) == CAL_LOW ? GLOBAL_KL1 : GLOBAL_KH1)+((icn)-1)))
 
 class ArduinoTx {
 	private:
@@ -94,12 +76,59 @@ class ArduinoTx {
 		byte CommitChanges_bool; // set by CommitChanges(), reset by Refresh()
 	
 		// Local copy of the values of the global variables
-		int Global_int[GLOBAL_VARS];
+		GlobalSettings Global_obj;
 
 		// Local copy of the values of the variables of the current dataset
-		int DatasetModel_int[VARS_PER_MODEL];
-		int DatasetMixers_int[NMIXERS][VARS_PER_MIXER];
-		int DatasetChannels_int[CHANNELS][VARS_PER_CHANNEL];
+		DatasetSettings Dataset_obj;
+
+		// Access the variables of given mixer
+		// idxmixer : 0-based, mixer number - 1
+		const MixerSettings *get_mixer(byte idxmixer_byt) { return &Dataset_obj.Mixers_obj[idxmixer_byt]; }
+
+		// Access the variables of given channel
+		// idxchan : 0-based, channel number - 1
+		const ChannelSettings *get_channel(byte idxchan_byt) { return &Dataset_obj.Channels_obj[idxchan_byt]; }
+
+		// Access the calibration value for given potentiometer
+		// icn=control (potentiometer) number defined in channel var ICN, 1-based
+		// calvar calibration variable (CAL_LOW, CAL_HIGH)
+		// return value: lowest/highest value returned by the potentiometer corresponding to given channel [0, 1023]
+		int get_calibration(byte icn_byt, byte calvar_byt) { return Global_obj.Cal_int[calvar_byt][icn_byt - 1]; }
+
+		// Transfer plan of each channel ----------------------------------------------------------
+		// compiled by load_settings() from the channel variables, executed by ComputeChannelPulse()
+		// the settings do not change between frames, so all maps and percentages are turned into integer coefficients once
+		
+		typedef enum Rates {
+			RATE_NONE,		// no dual rate and no exponential
+			RATE_DUAL,		// dual rate: value = (RateBase_lng + value * RateScale_lng) >> 16
+			RATE_EXPO,		// centered symetrical exponential curve, RateScale_lng = expoScale(EXP)
+			RATE_EXPO_FULL	// full exponential curve for the throttle channel, RateScale_lng = expoScale(EXP)
+		} Rate;
+		
+		typedef struct ChannelPlans {
+			byte Rate_byt;				// Rate applied when the dual rate switch is ON
+			byte Throttle_bool;			// true=this is the throttle channel
+			byte Priority_byt;			// OUTPUT_PRIORITY_*, see arduinotx_output.h
+			long RateScale_lng;			// 65536=1 for dual rate, negative below 1%
+			long RateBase_lng;
+			int Trim_int;				// subtrim offset, added to the value
+			int Low_int;				// value is constrained to [Low_int, High_int] after subtrim (ENDPOINTS_LIMITED dead-angles)
+			int High_int;
+			long Base_lng[2];			// pulse = (Base_lng[s] + value * Slope_lng[s]) >> 16 ; s=0 if value < 512, s=1 otherwise
+			long Slope_lng[2];			// end points, reverse and pulse range in quarter microseconds
+			unsigned int CutPulse_int[2];	// pulse sent while the throttle is cut, [0]=dual rate OFF, [1]=dual rate ON
+		} ChannelPlan;
+		
+		ChannelPlan ChannelPlans_obj[CHANNELS];
+		
+		// Input samples of the current frame ----------------------------------------------------------
+		// refreshed once per frame by SampleInputs(), read by ReadControl()
+		
+		unsigned int Inputs_int[NPOTS]; // calibrated value of each potentiometer, [0, 1023]
+		byte Switches_byt; // state of each switch, bit 0 = switch 1, 1=HIGH
+		byte PotsUsed_byt; // potentiometers read by a channel or a mixer of the current model, bit 0 = pot 1
+		unsigned long CalScale_lng[NPOTS]; // calibration slope of each potentiometer, 65536=1, see compile_inputs()
 
 		// Morse codes flashed on the Led ----------------------------------------------------------
 		
@@ -112,13 +141,17 @@ class ArduinoTx {
 		byte get_selected_dataset();
 		RunMode refresh_runmode();
 		void refresh_led_code();
-		void send_ppm();
 		void load_settings();
 		byte check_throttle();
+		void compile_channel(byte chan_byt, ChannelPlan *out_plan);
+		unsigned int run_plan(const ChannelPlan *plan, unsigned int value_int, byte dualrate_bool);
 #ifdef BATCHECK_ENABLED
 		byte check_battery();
 #endif
-		unsigned int read_potentiometer(byte pot_number_byt);
+		unsigned int calibrate_potentiometer(byte pot_number_byt, unsigned int raw_int);
+		unsigned int get_input(byte pot_number_byt);
+		void compile_inputs();
+		void apply_link_settings();
 #if MODEL_SWITCH_BEHAVIOUR == MODEL_SWITCH_STEPPING    
     void process_model_switch_stepping();
     byte debounce_modelswitch();
@@ -130,7 +163,7 @@ class ArduinoTx {
 	public:
 		// PPM signal -----------------------------------------------------------------
 
-		static const byte PPM_PIN;	// PPM output pin, hard-wired to ISR Timer 1 on ATMega 328
+		static const byte PPM_PIN;	// PPM output pin, hard-wired to Timer 1 compare match B (OC1B) on ATMega 328, see arduinotx_ppm.h
 		static const unsigned int PPM_PERIOD; // microseconds; send PPM sequence every 20ms for 6 channels
 		static const unsigned int PPM_LOW;	// microseconds; fixed channel sync pulse width in the PPM signal
 
@@ -138,8 +171,10 @@ class ArduinoTx {
 		void Init();
 		void Refresh();
 		void CommitChanges();
+		byte SampleInputs(unsigned int out_pots_int[]);
 		unsigned int ReadControl(byte chan_byt);
 		unsigned int ComputeChannelPulse(byte chan_byt, unsigned int ana_value_int);
+		byte GetChannelPriority(byte chan_byt);
 #ifdef BATCHECK_ENABLED
     unsigned int ReadBattery();
 #endif
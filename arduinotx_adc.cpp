@@ -0,0 +1,101 @@
+/* arduinotx_adc.cpp - Background ADC scanner
+** 16-10-2026 created
+** 16-10-2026 halWait() in busy loop for the host build
+
+Copyright (C) 2014-26 Gregor Schlechtriem.  All rights reserved.
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+Contact information: http://www.pikoder.com
+*/
+
+#include "arduinotx_adc.h"
+#include "arduinodtx_transmitter.h"
+#include "arduinotx_hal.h"
+
+/* 
+** Variables allocated in arduinodtx.ino  --------------------------------------------
+*/
+
+// ADC scanner
+extern ArduinotxAdc Adc_obj;
+
+ISR(ADC_vect) {
+	Adc_obj.Complete();
+}
+
+/*
+** Public -----------------------------------------------------------------
+*/
+
+// Start the background conversions, returns when the first sweep is complete
+void ArduinotxAdc::Init() {
+	for (byte icn_byt = 1; icn_byt <= NPOTS; icn_byt++)
+		Mux_byt[ADC_POT(icn_byt)] = get_pot_pin(icn_byt);
+#ifdef BATCHECK_ENABLED
+	Mux_byt[ADC_BATTERY] = BATCHECK_PIN - A0;
+#endif
+#if MODEL_SWITCH_BEHAVIOUR == MODEL_SWITCH_ROTATING
+	Mux_byt[ADC_MODEL_SWITCH] = MODEL_ROTATING_SWITCH_PIN - A0;
+#endif
+	Front_byt = 0;
+	Sweeps_byt = 0;
+	Input_idx_byt = 0;
+	
+	// the ADC prescaler has been set by the Arduino core: 125 kHz, 104 microseconds per conversion
+	ADCSRA |= _BV(ADIE); // enable the ADC complete interrupt
+	start_conversion();
+	while (Sweeps_byt == 0) halWait(); // wait until ISR(ADC_vect) publishes the first sweep
+}
+
+// Return the latest raw value of given input
+// input_byt : ADC_POT(n), ADC_BATTERY, ADC_MODEL_SWITCH
+// Return value: [0, 1023]
+unsigned int ArduinotxAdc::Read(byte input_byt) {
+	byte sreg_byt = SREG;
+	cli(); // the ISR may publish a new sweep while we are reading 2 bytes
+	unsigned int retval_int = Samples_int[Front_byt][input_byt];
+	SREG = sreg_byt;
+	return retval_int;
+}
+
+// Copy the latest complete sweep of all inputs into given array
+// out_samples_int : user-allocated, ADC_INPUTS items
+void ArduinotxAdc::Snapshot(unsigned int out_samples_int[]) {
+	byte sreg_byt = SREG;
+	cli();
+	byte front_byt = Front_byt;
+	for (byte idx_byt = 0; idx_byt < ADC_INPUTS; idx_byt++)
+		out_samples_int[idx_byt] = Samples_int[front_byt][idx_byt];
+	SREG = sreg_byt;
+}
+
+// Store the result of the current conversion and start the next one
+// called by ISR(ADC_vect)
+void ArduinotxAdc::Complete() {
+	byte back_byt = Front_byt ^ 1;
+	unsigned int sample_int = ADC;
+#ifdef BATCHECK_ENABLED
+	if (Input_idx_byt == ADC_BATTERY && Sweeps_byt)
+		sample_int = (7 * Samples_int[Front_byt][ADC_BATTERY] + sample_int) >> 3; // average the battery voltage over the last 8 sweeps
+#endif
+	Samples_int[back_byt][Input_idx_byt] = sample_int;
+	if (++Input_idx_byt == ADC_INPUTS) {
+		// publish the complete sweep
+		Input_idx_byt = 0;
+		Front_byt = back_byt;
+		if (Sweeps_byt < 255)
+			Sweeps_byt++;
+	}
+	start_conversion();
+}
+
+/*
+** Private -----------------------------------------------------------------
+*/
+
+// Start the conversion of input Input_idx_byt
+void ArduinotxAdc::start_conversion() {
+	ADMUX = _BV(REFS0) | (Mux_byt[Input_idx_byt] & 0x07); // AVcc reference, same as analogReference(DEFAULT)
+	ADCSRA |= _BV(ADSC);
+}
@@ -0,0 +1,53 @@
+/* arduinotx_adc.h - Background ADC scanner
+** 16-10-2026 created
+
+Copyright (C) 2014-26 Gregor Schlechtriem.  All rights reserved.
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+Contact information: http://www.pikoder.com
+
+The ADC complete interrupt converts all analog inputs in turn, the next conversion is started as soon as the previous one is complete.
+A complete sweep of all inputs takes about 100 microseconds per input.
+Samples are double-buffered: the ISR fills the back buffer, then publishes it as the front buffer at the end of each sweep.
+Warning: analogRead() must not be called anymore once Init() has been called.
+*/
+
+#ifndef arduinotx_adc_h
+#define arduinotx_adc_h
+#include <Arduino.h>
+#include "arduinotx_config.h"
+
+// Index of the analog inputs in the sample array
+// potentiometers first, potentiometer 1 is input 0, pot 2 is input 1...
+#define ADC_POT(icn) ((icn) - 1)
+#ifdef BATCHECK_ENABLED
+#define ADC_BATTERY NPOTS
+#define ADC_BATTERY_INPUTS 1
+#else
+#define ADC_BATTERY_INPUTS 0
+#endif
+#if MODEL_SWITCH_BEHAVIOUR == MODEL_SWITCH_ROTATING
+#define ADC_MODEL_SWITCH (NPOTS + ADC_BATTERY_INPUTS)
+#define ADC_INPUTS (NPOTS + ADC_BATTERY_INPUTS + 1)
+#else
+#define ADC_INPUTS (NPOTS + ADC_BATTERY_INPUTS)
+#endif
+
+class ArduinotxAdc {
+	private:
+		byte Mux_byt[ADC_INPUTS]; // ADC multiplexer channel of each input
+		volatile unsigned int Samples_int[2][ADC_INPUTS]; // [buffer][input], raw values [0, 1023]
+		volatile byte Front_byt; // index of the buffer holding the latest complete sweep
+		volatile byte Sweeps_byt; // number of complete sweeps, saturates at 255
+		byte Input_idx_byt; // input being converted
+		
+		void start_conversion();
+	
+	public:
+		void Init();
+		unsigned int Read(byte input_byt);
+		void Snapshot(unsigned int out_samples_int[]);
+		void Complete();
+};
+#endif
@@ -36,11 +36,33 @@ Contact information: http://www.reseau.org/arduinorc/index.php?n=Main.Contact
 ** GS changes: 
 ** 09-10-2015 revised PROGMEM vaiabledefs to latest avr-Compiler (>= 1.6) requirements
 ** 01-11-2016 merged latest version of arduinotx (1.5.5) into arduinodtx
+** 16-10-2026 new command PRINT SSC
+** 16-10-2026 validate_value() case 10 for SBR, new command BENCH
+** 16-10-2026 variables found by ArduinotxEeprom::FindVar(), validate_value() replaced by ArduinotxEeprom::Validate()
+** 16-10-2026 halWait() in busy loop for the host build
+** 16-10-2026 new command PRINT STATS
+** 16-10-2026 PRINT STATS prints the EEPROM bytes written and skipped
+** 16-10-2026 CHECK verifies the checksum of the global variables and of each dataset
+** 16-10-2026 new commands EXPORT and IMPORT: binary transfer of the global variables or of a dataset
+** 16-10-2026 console at CONSOLE_BAUDRATE, new commands BAUD and FLOW (XON/XOFF), upload summary printed by ECHO
+** 16-10-2026 PRINT PPM reads the snapshot of the last frame instead of waiting for the frame ISR
+** 16-10-2026 new command STREAM: binary telemetry records sent by Refresh()
+** 16-10-2026 console output without avr-libc stdio: putchar(), puts() and sprintf() replaced, see arduinotx_lib.cpp
+** 16-10-2026 DUMP continued by Refresh() while the transmit buffer has room, the input waits until the end of the dump
+** 16-10-2026 new commands COPY MODEL and DIFF
+** 16-10-2026 STREAM records built from the snapshot of the frame only
+** 16-10-2026 MODEL checks the dataset number with ArduinotxEeprom::Validate()
+** 16-10-2026 frame of IMPORT abandoned by Refresh() after FRAME_TIMEOUT, abort_import()
 */
 
 #include "arduinotx_command.h"
 #include "arduinotx_eeprom.h"
 #include "arduinotx_lib.h"
+#include "arduinotx_adc.h"
+#include "arduinotx_ssc.h"
+#include "arduinotx_output.h"
+#include "arduinotx_ppm.h"
+#include "arduinotx_snapshot.h"
 
 #define CMDECHO_PROMPT  0x4
 #define CMDECHO_REPLY  0x2
@@ -49,6 +71,10 @@ Contact information: http://www.reseau.org/arduinorc/index.php?n=Main.Contact
 // test for EOL char in command input
 #define isEOL(c) ((c) == '\n' || (c) == '\r')
 
+// software flow control characters, see FLOW
+#define XON 0x11
+#define XOFF 0x13
+
 /* 
 ** Variables allocated in arduinotx.ino
 */
@@ -56,15 +82,35 @@ Contact information: http://www.reseau.org/arduinorc/index.php?n=Main.Contact
 extern ArduinotxEeprom Eeprom_obj;
 // Tx manager
 extern ArduinoTx ArduinoTx_obj;
-// These 2 global variables are used to request the PPM signal values from ISR(TIMER1_COMPA_vect)
-extern volatile byte RequestPpmCopy_bool;
-extern volatile unsigned int PpmCopy_int[]; // pulse widths (microseconds)
+// ADC scanner
+extern ArduinotxAdc Adc_obj;
+// miniSSC transmitter
+extern ArduinotxSsc Ssc_obj;
+// Output scheduler
+extern ArduinotxOutput Output_obj;
+// Frame clock and PPM generator
+extern ArduinotxPpm Ppm_obj;
+// Channel values of the last frame
+extern ArduinotxSnapshot Snapshot_obj;
+
+
+// the telemetry records are built in Frame_byt[]
+static_assert(STREAM_BYTES <= FRAME_BYTES, "Frame_byt[] too small for a telemetry record");
+static_assert(NSWITCHES <= 8, "the telemetry record has one byte for the switches");
 
+// baud rates accepted by BAUD
+const unsigned long ArduinotxCmd::ConsoleBaudrates_lng[] PROGMEM = {2400, 4800, 9600, 19200, 38400, 57600, 115200};
 
 void ArduinotxCmd::InitCommand() {
-	serialInit(2400);
+	serialInit(CONSOLE_BAUDRATE);
 	
 	Echo_byt= CMDECHO_PROMPT | CMDECHO_REPLY | CMDECHO_INPUT;
+	Flow_bool = false;
+	Baudrate_lng = CONSOLE_BAUDRATE;
+	StreamPeriod_int = 0;
+	Dump_bool = false;
+	Upload_bool = false;
+	ImportBlock_byt = IMPORT_NONE;
 	strcpy_P(Cmdline_str, PSTR("ECHO COMMAND MODE")); process_command_line(Cmdline_str);
 	strcpy_P(Cmdline_str, PSTR("PRINT VERSION")); process_command_line(Cmdline_str);
 	if (Eeprom_obj.CheckEEProm() > 0) {
@@ -79,11 +125,13 @@ void ArduinotxCmd::InitCommand() {
 }
 
 void ArduinotxCmd::EndCommand() {
+	StreamPeriod_int = 0;
+	Dump_bool = false;
 	Serial.end();
 }
 
 void ArduinotxCmd::serial_prompt() {
-	aPrintf(PSTR("%d> "), Eeprom_obj.GetVar(0, "CDS"));
+	aPrintf(PSTR("%d> "), Eeprom_obj.GetVar(0, VAR_GLOBAL(GLOBAL_CDS)));
 }
 
 /* Acquire character(s) received from the serial link
@@ -93,6 +141,9 @@ void ArduinotxCmd::Input() {
 	static byte idx_byt = 0;
 	const byte ESC = 27; // Escape key
 	
+	if (Dump_bool)
+		return; // the characters received wait in the receive buffer until the end of DUMP, see Refresh()
+
 	if (idx_byt == 0)
 		memset(Cmdline_str, '\0', CMDLINESIZE + 1);
 
@@ -100,13 +151,22 @@ void ArduinotxCmd::Input() {
 		// get the new byte
 		byte read_byt = Serial.read();
 		
+		// frame of the IMPORT command, abandoned if the sender stopped
+		if (ImportBlock_byt != IMPORT_NONE) {
+			if (millis() - FrameTime_lng <= FRAME_TIMEOUT) {
+				import_byte(read_byt);
+				continue;
+			}
+			abort_import();
+		}
+
 		// echo input
 		if (Echo_byt & CMDECHO_INPUT) {
 			if (read_byt >= ' ')
-				putchar(read_byt);
+				Serial.write(read_byt);
 			else if (read_byt == ESC) {
 				// escape: send a \r \n EOL sequence 
-				puts("\r");
+				aPrintfln(PSTR(""));
 			}
 			else if (! isEOL(read_byt))
 				aPrintf(PSTR("0x%02x"), read_byt);
@@ -115,20 +175,28 @@ void ArduinotxCmd::Input() {
 		// parse input
 		if (isEOL(read_byt)) {
 			if (Echo_byt & CMDECHO_INPUT)
-				puts("\r"); // send a \r \n EOL sequence
+				aPrintfln(PSTR("")); // send a \r \n EOL sequence
 		
 			if (idx_byt)  { // else ignore empty commands
 				Cmdline_str[idx_byt] = '\0';
 				char *comment_chr = strchr(Cmdline_str, COMMENT_TOKEN); // strip comments
 				if (comment_chr)
 					*comment_chr = '\0';
-				if (! Isblank(Cmdline_str))
+				if (! Isblank(Cmdline_str)) {
+					// the characters received while the command is executed, e.g. waiting for the EEPROM, would overflow the receive buffer
+					if (Flow_bool)
+						Serial.write(XOFF);
 					process_command_line(Trimwhitespace(Cmdline_str));
+					if (Flow_bool && !Dump_bool) // else at the end of DUMP
+						Serial.write(XON);
+				}
 				idx_byt = 0;
 			}
 
-			if (Echo_byt & CMDECHO_PROMPT)
+			if ((Echo_byt & CMDECHO_PROMPT) && ImportBlock_byt == IMPORT_NONE && !Dump_bool) // else after the frame of IMPORT or at the end of DUMP
 				serial_prompt();
+			if (Dump_bool)
+				break; // the next command lines are read at the end of DUMP
 		}
 		else if (read_byt == ESC) {
 			// escape: cancel user input
@@ -144,14 +212,48 @@ void ArduinotxCmd::Input() {
 	}
 }
 
+// Print the next lines of DUMP and send the telemetry record when it is due, see STREAM
+// Abandon the frame of IMPORT if the sender has stopped
+// This method is called by loop(), it never waits for the Serial transmit buffer
+void ArduinotxCmd::Refresh() {
+	if (ImportBlock_byt != IMPORT_NONE && millis() - FrameTime_lng > FRAME_TIMEOUT && !Serial.available())
+		abort_import(); // else Input() receives the next byte first
+	if (Dump_bool) {
+		byte end_bool = false;
+		while (!end_bool && Serial.availableForWrite() >= SERIALIZED_LINE_BYTES) {
+			if (DumpDiff_bool)
+				end_bool = Eeprom_obj.DiffLine(DumpDataset_byt, DumpReference_byt, &DumpItem_int) != 0;
+			else
+				end_bool = Eeprom_obj.SerializeLine(DumpDataset_byt, DumpChannel_byt, &DumpItem_int) != 0;
+			if (!end_bool)
+				DumpLines_int++;
+		}
+		if (end_bool) {
+			Dump_bool = false;
+			if (DumpDiff_bool)
+				aPrintfln(PSTR("%c %d changed"), COMMENT_TOKEN, DumpLines_int); // shorter than SERIALIZED_LINE_BYTES
+			if (Flow_bool)
+				Serial.write(XON);
+			if (Echo_byt & CMDECHO_PROMPT)
+				serial_prompt();
+		}
+	}
+	if (StreamPeriod_int && ImportBlock_byt == IMPORT_NONE && millis() - StreamTime_lng >= StreamPeriod_int && Serial.availableForWrite() >= STREAM_BYTES) {
+		StreamTime_lng += StreamPeriod_int;
+		if (millis() - StreamTime_lng >= StreamPeriod_int)
+			StreamTime_lng = millis(); // late, e.g. after a command: skip the records missed
+		stream_record();
+	}
+}
+
 // Increment the Current dataset number, simulating a "MODEL x" command line
 // this method is called by ArduinoTx::get_selected_dataset() when MODEL_SWITCH_STEPPING has been selected
 #if MODEL_SWITCH_BEHAVIOUR == MODEL_SWITCH_STEPPING
 void ArduinotxCmd::NextDataset() {
-  byte ds_byt = Eeprom_obj.GetVar(0, "CDS");
+  byte ds_byt = Eeprom_obj.GetVar(0, VAR_GLOBAL(GLOBAL_CDS));
   if (ds_byt == NDATASETS)
     ds_byt = 0;
-  sprintf(Cmdline_str, "MODEL %d", ++ds_byt);
+  aSprintf(Cmdline_str, sizeof(Cmdline_str), PSTR("MODEL %d"), ++ds_byt);
   process_command_line(Cmdline_str);
 }
 // Change the Current dataset number, simulating a "MODEL x" command line
@@ -160,7 +262,7 @@ void ArduinotxCmd::NextDataset() {
 #elif MODEL_SWITCH_BEHAVIOUR == MODEL_SWITCH_ROTATING
 void ArduinotxCmd::SelectDataset(byte dataset_int) {
   if (dataset_int > 0 && dataset_int <= NDATASETS) {
-    sprintf(Cmdline_str, "MODEL %d", dataset_int);
+    aSprintf(Cmdline_str, sizeof(Cmdline_str), PSTR("MODEL %d"), dataset_int);
     process_command_line(Cmdline_str);
   }
 }
@@ -169,11 +271,15 @@ void ArduinotxCmd::SelectDataset(byte dataset_int) {
 const char Cmd_CHECK[] PROGMEM = "CHECK"; const char Cmd_INIT[] PROGMEM = "INIT"; 
 const char Cmd_ECHO[] PROGMEM = "ECHO"; const char Cmd_MODEL[] PROGMEM = "MODEL"; 
 const char Cmd_DUMP[] PROGMEM = "DUMP"; const char Cmd_PRINT[] PROGMEM = "PRINT"; 
-const char Cmd_QUMARK[] PROGMEM = "?"; 
+const char Cmd_QUMARK[] PROGMEM = "?"; const char Cmd_BENCH[] PROGMEM = "BENCH"; 
+const char Cmd_EXPORT[] PROGMEM = "EXPORT"; const char Cmd_IMPORT[] PROGMEM = "IMPORT"; 
+const char Cmd_BAUD[] PROGMEM = "BAUD"; const char Cmd_FLOW[] PROGMEM = "FLOW"; 
+const char Cmd_STREAM[] PROGMEM = "STREAM"; const char Cmd_COPY[] PROGMEM = "COPY"; 
+const char Cmd_DIFF[] PROGMEM = "DIFF"; 
 // Names of all commands in same order as enum CmdTokens
 PGM_P const ArduinotxCmd::AllCommands_str[] PROGMEM = {
-	Cmd_CHECK, Cmd_INIT, Cmd_ECHO, Cmd_MODEL, Cmd_DUMP, Cmd_PRINT, Cmd_QUMARK,
-	NULL
+	Cmd_CHECK, Cmd_INIT, Cmd_ECHO, Cmd_MODEL, Cmd_DUMP, Cmd_PRINT, Cmd_QUMARK, Cmd_BENCH, Cmd_EXPORT, Cmd_IMPORT, Cmd_BAUD, Cmd_FLOW, Cmd_STREAM, Cmd_COPY,
+	Cmd_DIFF, NULL
 };
 
 // Parse the command line
@@ -212,97 +318,6 @@ ArduinotxCmd::CmdToken ArduinotxCmd::parse_command_line(const char *line_str, ch
 }
 
 
-// Names of all variables that could be tested by validate_value()
-PGM_P const ArduinotxCmd::AllVarNames_str[] PROGMEM = {
-	Gvn_TSC, Gvn_CDS, Gvn_ADS, Gvn_BAT, Gvn_THC, Gvn_N1M, Gvn_P1M, Gvn_N2M, Gvn_P2M, Gvn_ICT,
-	Gvn_ICN, Gvn_REV, Gvn_DUA, Gvn_EXP, Gvn_PWL, Gvn_PWH, Gvn_EPL, Gvn_EPH, Gvn_SUB,
-	Gvn_KL1, Gvn_KL2, Gvn_KL3, Gvn_KL4, Gvn_KL5, Gvn_KL6, Gvn_KL7, Gvn_KL8, 
-	Gvn_KH1, Gvn_KH2, Gvn_KH3, Gvn_KH4, Gvn_KH5, Gvn_KH6, Gvn_KH7, Gvn_KH8, 
-	NULL
-};
-
-// Test number corresponding to variable name in AllVarNames_str[]
-// AllVarTests_byt[] must be declared at class level because pgm_read_byte() will return wrong value if AllVarTests_byt[] is declared inside validate_value()
-const byte ArduinotxCmd::AllVarTests_byt[] PROGMEM = {
-  9,6,6,8,7,4,2,4,2,3,
-  4,0,1,1,5,5,1,1,2,
-  8,8,8,8,8,8,8,8,
-  8,8,8,8,8,8,8,8
-};
-	
-// Test if given numerical value is valid for given variable
-// Return value: 0=valid, 1=out of range
-byte ArduinotxCmd::validate_value(const char *var_str, int value_int) {
-	byte retval_byt = 1;
-	char var3_str[4]; var3_str[0] = var_str[0]; var3_str[1] = var_str[1]; var3_str[2] = var_str[2]; var3_str[3] = '\0';
-	// seek index of var3_str in AllVarNames_str[]
-	int idx_int = findProgmemStrArrayIndex(AllVarNames_str, var3_str);
-	if (idx_int >= 0) {
-		switch (pgm_read_byte(&AllVarTests_byt[idx_int])) {
-			case 0:
-				// REV : Reverse, 1=servo direction is reversed for this channel, 0=servo direction is not reversed.
-				if (value_int == 0 || value_int == 1)
-					retval_byt = 0;
-				break;
-			case 1:
-				// DUA : Dual rate applied to this channel when the Dual Rate switch is ON. Percentage [0-100].
-				// EXP : Exponential percentage applied to the input value, [0-100] 
-				// EPL, EPH : End point percentage [0-100], EPL=low end point, EPH=high end point, both default=100.
-				if (value_int >= 0 && value_int <= 100)
-					retval_byt = 0;
-				break;
-			case 2:
-				// SUB : Subtrim percentage [-100, +100], default=0.
-				// P1M, P2M: mixer 1 & 2's percent mix [-100, +100]
-				if (value_int >= -100 && value_int <= 100)
-					retval_byt = 0;
-				break;
-			case 3:
-				// ICT : Input control type: 1=potentiometer, 2=switch, 3=mixer, 0=off (do not read this control)
-				if (value_int >= 0 && value_int <= 3)
-					retval_byt = 0;
-				break;
-			case 4:
-				// ICN : Input control number: potentiometer number or switch number
-				// potentiometer number belongs to the interval [1,8]
-				// switch number belongs to the interval [1,6]
-				// N1M, N2M : mixer 1 & 2's input1 potentiometer number [1,8] or 0=none
-				if (value_int >= 0 && value_int <= 8)
-					retval_byt = 0;
-				break;
-			case 5:
-				// PWL, PWH : Minimal/Maximal pulse width for this channel, in microseconds
-				if (value_int >= (int)ArduinoTx::PPM_LOW && value_int <= 10 * (int)ArduinoTx::PPM_LOW)
-					retval_byt = 0;
-				break;
-			case 6:
-				// CDS : current dataset ; this is the model selected by the MODEL command
-				// ADS : alternate dataset ; this is the model selected when the MODEL_SWITCH is closed
-				if (value_int >= 1 && value_int <= NDATASETS)
-					retval_byt = 0;
-				break;
-			case 7:
-				// THC : throttle channel (controlled by the throttle cut switch) ; default = 3, no throttle channel = 0
-				if (value_int >= 0 && value_int <= CHANNELS)
-					retval_byt = 0;
-				break;
-			case 8:
-				//BAT : minimum battery voltage required for Tx operation, ALARM_BATTERY is triggered when voltage gets lower. 
-				//KL1-8 : lowest analog value read on potentiometer #1, when the stick (and the hardware trim, if any) is at its lowest position. KL1...KL8 correspond to potentiometers 1 to 9. Value in the range [0-1023]
-				//KH1-8 : highest analog value read on potentiometer #1, when the stick (and the hardware trim, if any) is at its highest position. KH1...KH8 correspond to potentiometers 1 to 9. Value in the range [0-1023]
-				if (value_int >= 0 && value_int <= 1023)
-					retval_byt = 0;
-				break;
-			case 9:
-				// TSC : throttle cutoff value used by the throttle security check, [0-511]
-				if (value_int >= 0 && value_int <= 511)
-					retval_byt = 0;
-				break;
-		}
-	}
-	return retval_byt;
-}
-	
 // Process command
 void ArduinotxCmd::process_command_line(char *line_str) {
 	int value_int = 0;
@@ -319,13 +334,27 @@ void ArduinotxCmd::process_command_line(char *line_str) {
 	//~ aPrintfln(PSTR("    word2_str = \"%s\""), word2_str);
 	
 	byte valid_bool = false;
+	if (Upload_bool && token_int != CMD_ECHO)
+		UploadLines_int++;
 	
 	// execute the command
 	switch (token_int) {
 		case CMD_CHECK:
 			value_int = Eeprom_obj.CheckEEProm();
-			if (value_int > 0)
-				aPrintfln(PSTR("EEPROM ok, %d bytes"), value_int);
+			if (value_int > 0) {
+				byte errors_byt = 0;
+				for (byte ds_byt = 0; ds_byt <= NDATASETS; ds_byt++) {
+					if (Eeprom_obj.CheckBlock(ds_byt) != 0) {
+						if (ds_byt == 0)
+							aPrintfln(PSTR("GLOBAL: checksum error"));
+						else
+							aPrintfln(PSTR("MODEL %d: checksum error"), ds_byt);
+						errors_byt++;
+					}
+				}
+				if (errors_byt == 0)
+					aPrintfln(PSTR("EEPROM ok, %d bytes"), value_int);
+			}
 			else
 				print_command_error_P(PSTR("EEPROM"));
 		break;
@@ -339,22 +368,91 @@ void ArduinotxCmd::process_command_line(char *line_str) {
 				print_command_error_P(PSTR("EEPROM initialization"));
 		break;
 
+		// echo UPLOAD		starts counting the command lines and the errors
+		// echo ON|OFF		prints the upload summary if an upload was started
 		case CMD_ECHO:
+			if (Upload_bool) {
+				aPrintfln(PSTR("UPLOAD: %u lines, %u applied, %u rejected, %lu ms"), UploadLines_int, UploadLines_int - UploadErrors_int, UploadErrors_int, millis() - UploadStart_lng);
+				Upload_bool = false;
+			}
 			if (strcmp(word2_str, "OFF") == 0) 
 				Echo_byt = 0;
 			else if (strcmp(word2_str, "ON") == 0)
 				Echo_byt = CMDECHO_PROMPT | CMDECHO_REPLY | CMDECHO_INPUT;
-			else if (strcmp(word2_str, "UPLOAD") == 0) 
+			else if (strcmp(word2_str, "UPLOAD") == 0) {
 				Echo_byt = CMDECHO_PROMPT | CMDECHO_REPLY;
+				Upload_bool = true;
+				UploadLines_int = 0;
+				UploadErrors_int = 0;
+				UploadStart_lng = millis();
+			}
 			if (Echo_byt & CMDECHO_REPLY)
-				aprintfln(word2_str);
+				aPrintfln(PSTR("%s"), word2_str);
+		break;
+
+		// baud rate of the console until the end of the command mode, the reply is sent at the previous baud rate
+		case CMD_BAUD: {
+			unsigned long baudrate_lng = atol(word2_str);
+			for (byte idx_byt = 0; idx_byt < sizeof(ConsoleBaudrates_lng) / sizeof(ConsoleBaudrates_lng[0]); idx_byt++) {
+				if (baudrate_lng == pgm_read_dword(&ConsoleBaudrates_lng[idx_byt]))
+					valid_bool = true;
+			}
+			if (valid_bool) {
+				aPrintfln(PSTR("BAUD=%lu"), baudrate_lng);
+				Serial.flush(); // wait until the reply has been sent
+				Serial.begin(baudrate_lng);
+				Baudrate_lng = baudrate_lng;
+				StreamPeriod_int = 0; // the rate may not fit the new baud rate
+			}
+			else
+				print_command_error(word2_str);
+		}
+		break;
+
+		// flow ON		sends XOFF when a command line has been received and XON when it has been executed
+		// flow OFF		no flow control, the default
+		// The frames sent by EXPORT may contain XON and XOFF bytes, use FLOW OFF before EXPORT
+		case CMD_FLOW:
+			if (strcmp(word2_str, "ON") == 0 || strcmp(word2_str, "OFF") == 0) {
+				Flow_bool = (word2_str[1] == 'N');
+				if (Echo_byt & CMDECHO_REPLY)
+					aPrintfln(PSTR("FLOW=%s"), word2_str);
+			}
+			else
+				print_command_error(word2_str);
+		break;
+			
+		// stream ON hz		sends hz telemetry records per second, see STREAM_START
+		// stream OFF		stops the records
+		// The records are sent between the replies, the receiver finds them by their start byte, size and checksum
+		case CMD_STREAM:
+			if (strcmp(word2_str, "OFF") == 0) {
+				StreamPeriod_int = 0;
+				valid_bool = true;
+			}
+			else if (strncmp_P(word2_str, PSTR("ON "), 3) == 0) {
+				unsigned int hz_int = atoi(word2_str + 3);
+				// at most one record per frame, 10 bits per byte on the console
+				if (hz_int > 0 && hz_int <= 1000000L / cUpdateCycle && (unsigned long)hz_int * STREAM_BYTES * 10 * 100 <= Baudrate_lng * STREAM_LOAD) {
+					StreamPeriod_int = 1000 / hz_int;
+					StreamTime_lng = millis() - StreamPeriod_int; // first record now
+					StreamFrame_lng = 0;
+					valid_bool = true;
+				}
+			}
+			if (valid_bool) {
+				if (Echo_byt & CMDECHO_REPLY)
+					aPrintfln(PSTR("STREAM=%s"), word2_str);
+			}
+			else
+				print_command_error(word2_str);
 		break;
 			
 		case CMD_MODEL: {
 			// persist model number in the global vars dataset 0
 			// new value will be echoed in the prompt
 			value_int = atoi(word2_str);
-			if (Eeprom_obj.SetVar(0, "CDS", value_int) == 0) {
+			if (Eeprom_obj.Validate(VAR_GLOBAL(GLOBAL_CDS), value_int) == 0 && Eeprom_obj.SetVar(0, VAR_GLOBAL(GLOBAL_CDS), 0, value_int) == 0) {
 				if (Echo_byt & CMDECHO_REPLY)
 					aPrintfln(PSTR("MODEL=%d"), value_int);
 				ArduinoTx_obj.CommitChanges(); 
@@ -370,7 +468,7 @@ void ArduinotxCmd::process_command_line(char *line_str) {
 		// dump MIXERS	will dump all mixer vars of current model
 		// dump channel	will dump the specified channel of current model
 		case CMD_DUMP: { 
-			byte current_dataset_byt = Eeprom_obj.GetVar(0, "CDS");
+			byte current_dataset_byt = Eeprom_obj.GetVar(0, VAR_GLOBAL(GLOBAL_CDS));
 			byte dataset_byt = current_dataset_byt;
 			byte channel_byt = 0;
 			if (*word2_str == '\0')
@@ -397,38 +495,156 @@ void ArduinotxCmd::process_command_line(char *line_str) {
 			if (valid_bool) {
 				if (dataset_byt > 0)
 					aPrintfln(PSTR("MODEL %d"), current_dataset_byt);
-				Eeprom_obj.Serialize(dataset_byt, channel_byt);
+				// the lines are printed by Refresh()
+				Dump_bool = true;
+				DumpDiff_bool = false;
+				DumpDataset_byt = dataset_byt;
+				DumpChannel_byt = channel_byt;
+				DumpItem_int = 0;
 			}
 			else 
 				print_command_error(word2_str);
 		}
 		break;
 
-		case CMD_PRINT: { // print varname|pot#|sw#|ppm|ver
-			byte current_dataset_byt = Eeprom_obj.GetVar(0, "CDS");
-			byte dataset_byt = 255; 
-			if (Eeprom_obj.IsVar(current_dataset_byt, word2_str)) {
-				dataset_byt = current_dataset_byt; // model, mixer or channel dataset
+		// diff			will print the variables of current model that differ from their default value
+		// diff DEFAULTS	same as diff
+		// diff MODEL a b	will print the variables of model b that differ from model a
+		// The lines are printed by Refresh(), followed by the number of variables printed
+		case CMD_DIFF: {
+			byte dataset_byt = Eeprom_obj.GetVar(0, VAR_GLOBAL(GLOBAL_CDS));
+			byte reference_byt = 0;
+			if (*word2_str == '\0' || strcmp(word2_str, "DEFAULTS") == 0)
+				valid_bool = true;
+			else
+				valid_bool = parse_models(word2_str, &reference_byt, &dataset_byt);
+			if (valid_bool) {
+				aPrintfln(PSTR("MODEL %d"), dataset_byt);
+				Dump_bool = true;
+				DumpDiff_bool = true;
+				DumpDataset_byt = dataset_byt;
+				DumpReference_byt = reference_byt;
+				DumpItem_int = 0;
+				DumpLines_int = 0;
 			}
-			else if (Eeprom_obj.IsVar(0, word2_str))
-				dataset_byt = 0; // global dataset
+			else
+				print_command_error(word2_str);
+		}
+		break;
+
+		// copy MODEL a b	will copy all the variables of model a into model b, model name included
+		// Only the bytes that differ are written, see ArduinotxEeprom::WriteNext()
+		case CMD_COPY: {
+			byte source_byt, target_byt;
+			if (parse_models(word2_str, &source_byt, &target_byt) && Eeprom_obj.CheckEEProm() > 0
+				&& Eeprom_obj.GetBlock(source_byt, Frame_byt) == 0 && Eeprom_obj.SetBlock(target_byt, Frame_byt) == 0) {
+				if (Echo_byt & CMDECHO_REPLY)
+					aPrintfln(PSTR("COPY MODEL %d %d"), source_byt, target_byt);
+				ArduinoTx_obj.CommitChanges();
+			}
+			else
+				print_command_error(word2_str);
+		}
+		break;
+
+		// export GLOBAL	will send the frame of the global variables
+		// export		will send the frame of the current model
+		// export n		will send the frame of model n
+		case CMD_EXPORT: {
+			byte dataset_byt = *word2_str ? parse_block(word2_str) : Eeprom_obj.GetVar(0, VAR_GLOBAL(GLOBAL_CDS));
+			if (dataset_byt == IMPORT_NONE || export_block(dataset_byt) != 0)
+				print_command_error_P(PSTR("EXPORT"));
+		}
+		break;
+
+		// import		the next frame received will be written in the block given by the frame
+		// import GLOBAL	the next frame received must contain global variables
+		// import n		the next frame received must contain a dataset, it will be written in model n
+		// The bytes received by Input() go to import_byte() until the frame is complete
+		case CMD_IMPORT: {
+			byte dataset_byt = *word2_str ? parse_block(word2_str) : IMPORT_ANY;
+			if (dataset_byt != IMPORT_NONE && Eeprom_obj.CheckEEProm() > 0) {
+				ImportBlock_byt = dataset_byt;
+				FrameLength_byt = 0;
+				FrameTime_lng = millis();
+			}
+			else
+				print_command_error_P(PSTR("IMPORT"));
+		}
+		break;
+
+		// measure the SSC link at each baud rate that can be selected with SBR
+		case CMD_BENCH: {
+			for (byte idx_byt = 0; idx_byt < SSC_BAUDRATES; idx_byt++) {
+				ArduinotxSsc::SscBench bench_obj;
+				unsigned int sbr_int = pgm_read_word(&ArduinotxSsc::Baudrates_int[idx_byt]);
+				Ssc_obj.Bench(sbr_int * 100UL, &bench_obj);
+				aPrintfln(PSTR("SBR=%u: %lu bytes/s, latency %u us, jitter %d%%"), sbr_int, bench_obj.Throughput_lng, bench_obj.Latency_int, bench_obj.Jitter_byt);
+			}
+			// the packets queued by the frame ISR during the measures were not sent
+			noInterrupts();
+			Output_obj.Keyframe();
+			interrupts();
+		}
+		break;
+
+		case CMD_PRINT: { // print varname|pot#|sw#|ppm|ver
+			VarRef var_obj;
 			byte printed_bool = false;
-			if (dataset_byt < 255) {
-				char type_char = Eeprom_obj.GetType(dataset_byt, word2_str);
-				if (type_char == 'a') {
-					Eeprom_obj.GetVar(dataset_byt, word2_str, line_str);
+			if (Eeprom_obj.FindVar(word2_str, &var_obj)) {
+				byte dataset_byt = Eeprom_obj.IsGlobal(var_obj.Id_byt) ? 0 : Eeprom_obj.GetVar(0, VAR_GLOBAL(GLOBAL_CDS));
+				if (Eeprom_obj.GetType(var_obj.Id_byt) == 'a') {
+					Eeprom_obj.GetVar(dataset_byt, var_obj.Id_byt, var_obj.Number_byt, line_str);
 					aPrintfln(PSTR("%s=%s"), word2_str, line_str);
 					printed_bool = true;
 				}
 				else
-					value_int = Eeprom_obj.GetVar(dataset_byt, word2_str);
+					value_int = Eeprom_obj.GetVar(dataset_byt, var_obj.Id_byt, var_obj.Number_byt);
 				valid_bool = true;
 			}
 			else if (strcmp(word2_str, "PPM") == 0) {
-				RequestPpmCopy_bool = true; // query PPM values from ISR(TIMER1_COMPA_vect)
-				while (RequestPpmCopy_bool) ; // wait until ISR() updates PpmCopy_int[]
-				for (byte chan_byt = 0; chan_byt < CHANNELS; chan_byt++)
-					aPrintfln(PSTR("CH%d=%d"), chan_byt+1, PpmCopy_int[chan_byt]);
+				ArduinotxSnapshot::Snapshot snapshot_obj;
+				if (Snapshot_obj.Read(&snapshot_obj)) {
+					for (byte chan_byt = 0; chan_byt < CHANNELS; chan_byt++)
+						aPrintfln(PSTR("CH%d=%d"), chan_byt+1, snapshot_obj.Pulses_int[chan_byt] >> 2); // quarter microseconds to microseconds
+					printed_bool = true;
+				}
+			}
+			else if (strcmp(word2_str, "SSC") == 0) {
+				// miniSSC output queue statistics since last PRINT SSC
+				aPrintfln(PSTR("QUEUE=%d"), Ssc_obj.Depth());
+				aPrintfln(PSTR("MAXQUEUE=%d"), Ssc_obj.MaxDepth());
+				aPrintfln(PSTR("OVERFLOWS=%u"), Ssc_obj.Overflows());
+				aPrintfln(PSTR("JITTER=%d%%"), Ssc_obj.Jitter());
+				Ssc_obj.ResetStats();
+				printed_bool = true;
+			}
+			else if (strcmp(word2_str, "STATS") == 0 || strcmp(word2_str, "STATS RESET") == 0) {
+				// frame ISR statistics since last PRINT STATS RESET
+				ArduinotxPpm::FrameStats stats_obj;
+				noInterrupts();
+				Ppm_obj.GetStats(&stats_obj);
+				unsigned long bytes_lng = Output_obj.BytesSent();
+				byte max_bytes_byt = Output_obj.MaxBytes();
+				unsigned long ee_writes_lng = Eeprom_obj.Writes();
+				unsigned long ee_skipped_lng = Eeprom_obj.SkippedWrites();
+				if (word2_str[5]) {
+					Ppm_obj.ResetStats();
+					Output_obj.ResetStats();
+					Eeprom_obj.ResetStats();
+				}
+				interrupts();
+				unsigned long avg_bytes_lng = stats_obj.Frames_lng ? 10 * bytes_lng / stats_obj.Frames_lng : 0; // tenths of bytes
+				aPrintfln(PSTR("FRAMES=%lu"), stats_obj.Frames_lng);
+				aPrintfln(PSTR("ISRMIN=%u us"), stats_obj.MinDuration_int);
+				aPrintfln(PSTR("ISRAVG=%u us"), stats_obj.AvgDuration_int);
+				aPrintfln(PSTR("ISRMAX=%u us"), stats_obj.MaxDuration_int);
+				aPrintfln(PSTR("FRAMEJITTER=%u us"), stats_obj.Jitter_int);
+				aPrintfln(PSTR("OVERRUNS=%u"), stats_obj.Overruns_int);
+				aPrintfln(PSTR("BYTESAVG=%lu.%lu"), avg_bytes_lng / 10, avg_bytes_lng % 10);
+				aPrintfln(PSTR("BYTESMAX=%d"), max_bytes_byt);
+				aPrintfln(PSTR("EEWRITES=%lu"), ee_writes_lng);
+				aPrintfln(PSTR("EESKIPPED=%lu"), ee_skipped_lng);
 				printed_bool = true;
 			}
 			else if (strcmp(word2_str, "VERSION") == 0) {
@@ -456,8 +672,8 @@ void ArduinotxCmd::process_command_line(char *line_str) {
 				}
 				else {
 					number_byt = parse_last_digit("POT", word2_str); // raw value for given potentiometer
-					if (number_byt > 0) {
-						value_int = analogRead(get_pot_pin(number_byt)); 	
+					if (number_byt > 0 && number_byt <= NPOTS) {
+						value_int = Adc_obj.Read(ADC_POT(number_byt)); 	
 						valid_bool = true;
 					}
 					else {
@@ -482,21 +698,16 @@ void ArduinotxCmd::process_command_line(char *line_str) {
 		default: {
 			// varname=value
 			if (separator_chr == '=') { 
-				byte current_dataset_byt = Eeprom_obj.GetVar(0, "CDS"); 
-				byte dataset_byt = 255; 
-				if (Eeprom_obj.IsVar(current_dataset_byt, word1_str))
-					dataset_byt = current_dataset_byt; // model, mixer or channel dataset
-				else	if (Eeprom_obj.IsVar(0, word1_str))
-					dataset_byt = 0; // global dataset
-				
-				if (dataset_byt < 255) {
+				VarRef var_obj;
+				if (Eeprom_obj.FindVar(word1_str, &var_obj)) {
+					byte dataset_byt = Eeprom_obj.IsGlobal(var_obj.Id_byt) ? 0 : Eeprom_obj.GetVar(0, VAR_GLOBAL(GLOBAL_CDS));
 					// test var type
-					char var_type = Eeprom_obj.GetType(dataset_byt, word1_str);
+					char var_type = Eeprom_obj.GetType(var_obj.Id_byt);
 					if (var_type == 'a') {
 						// set string value
-						if  (Eeprom_obj.SetVar(dataset_byt, word1_str, 0, word2_str) == 0) {
+						if  (Eeprom_obj.SetVar(dataset_byt, var_obj.Id_byt, var_obj.Number_byt, 0, word2_str) == 0) {
 							if (Echo_byt & CMDECHO_REPLY) {
-								Eeprom_obj.GetVar(dataset_byt, word1_str, word2_str);
+								Eeprom_obj.GetVar(dataset_byt, var_obj.Id_byt, var_obj.Number_byt, word2_str);
 								aPrintfln(PSTR("%s=\"%s\""), word1_str, word2_str);
 							}
 							ArduinoTx_obj.CommitChanges();
@@ -507,10 +718,10 @@ void ArduinotxCmd::process_command_line(char *line_str) {
 					else {
 						// set numerical value
 						value_int = atoi(word2_str);
-						if (validate_value(word1_str, value_int) == 0) {
-							if  (Eeprom_obj.SetVar(dataset_byt, word1_str, value_int) == 0) {
+						if (Eeprom_obj.Validate(var_obj.Id_byt, value_int) == 0) {
+							if  (Eeprom_obj.SetVar(dataset_byt, var_obj.Id_byt, var_obj.Number_byt, value_int) == 0) {
 								if (Echo_byt & CMDECHO_REPLY)
-									aPrintfln(PSTR("%s=%d"), word1_str, Eeprom_obj.GetVar(dataset_byt, word1_str));
+									aPrintfln(PSTR("%s=%d"), word1_str, Eeprom_obj.GetVar(dataset_byt, var_obj.Id_byt, var_obj.Number_byt));
 								ArduinoTx_obj.CommitChanges(); 
 							}
 							else
@@ -530,6 +741,147 @@ void ArduinotxCmd::process_command_line(char *line_str) {
 	}
 }
 
+// Parse the block argument of EXPORT and IMPORT: "GLOBAL" or a model number
+// Return value: 0=global variables, dataset number [1, NDATASETS], or IMPORT_NONE if invalid
+// The number may be followed by a space and another argument, see parse_models()
+byte ArduinotxCmd::parse_block(const char *word_str) {
+	byte retval_byt = IMPORT_NONE;
+	if (strcmp(word_str, "GLOBAL") == 0)
+		retval_byt = 0;
+	else {
+		int dataset_int = atoi(word_str);
+		if (dataset_int > 0 && dataset_int <= NDATASETS)
+			retval_byt = dataset_int;
+	}
+	return retval_byt;
+}
+
+// Parse the argument "MODEL a b" of COPY and DIFF
+// Return value: true if a and b are dataset numbers [1, NDATASETS]
+byte ArduinotxCmd::parse_models(const char *word_str, byte *out_first_byt, byte *out_second_byt) {
+	byte retval_bool = false;
+	if (strncmp_P(word_str, PSTR("MODEL "), 6) == 0) {
+		const char *second_str = strchr(word_str + 6, ' ');
+		if (second_str) {
+			*out_first_byt = parse_block(word_str + 6);
+			*out_second_byt = parse_block(second_str + 1);
+			retval_bool = *out_first_byt != 0 && *out_first_byt != IMPORT_NONE && *out_second_byt != 0 && *out_second_byt != IMPORT_NONE;
+		}
+	}
+	return retval_bool;
+}
+
+// Send the frame of given block, see FRAME_START
+// dataset_byt: 0=global variables, or dataset number [1, NDATASETS]
+// Return value: 0=ok, 1=invalid dataset or invalid EEProm, 2=checksum error
+byte ArduinotxCmd::export_block(byte dataset_byt) {
+	byte retval_byt = 1;
+	byte size_byt = Eeprom_obj.BlockSize(dataset_byt);
+	if (size_byt > 0 && Eeprom_obj.CheckEEProm() > 0) {
+		retval_byt = Eeprom_obj.GetBlock(dataset_byt, Frame_byt + FRAME_HEADER);
+		if (retval_byt == 0) {
+			Frame_byt[0] = FRAME_START;
+			Frame_byt[1] = dataset_byt;
+			Frame_byt[2] = Eeprom_obj.GetVar(0, VAR_GLOBAL(GLOBAL_VER));
+			Frame_byt[3] = size_byt;
+			unsigned int checksum_int = Eeprom_obj.Checksum(Frame_byt + 1, FRAME_HEADER - 1 + size_byt);
+			Frame_byt[FRAME_HEADER + size_byt] = checksum_int & 0xFF;
+			Frame_byt[FRAME_HEADER + size_byt + 1] = checksum_int >> 8;
+			Serial.write(Frame_byt, FRAME_HEADER + size_byt + FRAME_TRAILER);
+		}
+	}
+	return retval_byt;
+}
+
+// Store a byte of the frame received after the IMPORT command, write the block when the frame is complete
+// The bytes before FRAME_START are ignored, e.g. the end of line of the IMPORT command
+void ArduinotxCmd::import_byte(byte read_byt) {
+	FrameTime_lng = millis();
+	if (FrameLength_byt > 0 || read_byt == FRAME_START) {
+		Frame_byt[FrameLength_byt++] = read_byt;
+		byte complete_bool = false;
+		byte error_bool = false;
+		if (FrameLength_byt == FRAME_HEADER) {
+			// the header must describe a block of this version of the EEProm layout
+			error_bool = Frame_byt[2] != Eeprom_obj.GetVar(0, VAR_GLOBAL(GLOBAL_VER)) || Frame_byt[3] == 0 || Frame_byt[3] != Eeprom_obj.BlockSize(Frame_byt[1]);
+		}
+		else if (FrameLength_byt > FRAME_HEADER && FrameLength_byt == FRAME_HEADER + Frame_byt[3] + FRAME_TRAILER) {
+			complete_bool = true;
+			error_bool = import_frame() != 0;
+		}
+		if (complete_bool || error_bool) {
+			ImportBlock_byt = IMPORT_NONE;
+			if (error_bool)
+				print_command_error_P(PSTR("IMPORT"));
+			if (Echo_byt & CMDECHO_PROMPT)
+				serial_prompt();
+		}
+	}
+}
+
+// Abandon the frame of the IMPORT command, the input returns to the command lines
+void ArduinotxCmd::abort_import() {
+	ImportBlock_byt = IMPORT_NONE;
+	print_command_error_P(PSTR("IMPORT"));
+	if (Echo_byt & CMDECHO_PROMPT)
+		serial_prompt();
+}
+
+// Write the block of the frame received after the IMPORT command
+// Return value: 0=ok, 1=invalid frame, 2=invalid value
+byte ArduinotxCmd::import_frame() {
+	byte retval_byt = 1;
+	byte size_byt = Frame_byt[3];
+	unsigned int checksum_int = Frame_byt[FRAME_HEADER + size_byt] | (Frame_byt[FRAME_HEADER + size_byt + 1] << 8);
+	byte dataset_byt = ImportBlock_byt == IMPORT_ANY ? Frame_byt[1] : ImportBlock_byt;
+	// a dataset can be written in another model, not into the global variables
+	if (Eeprom_obj.Checksum(Frame_byt + 1, FRAME_HEADER - 1 + size_byt) == checksum_int && (dataset_byt == 0) == (Frame_byt[1] == 0)) {
+		retval_byt = Eeprom_obj.SetBlock(dataset_byt, Frame_byt + FRAME_HEADER);
+		if (retval_byt == 0) {
+			if (Echo_byt & CMDECHO_REPLY) {
+				if (dataset_byt == 0)
+					aPrintfln(PSTR("IMPORT GLOBAL"));
+				else
+					aPrintfln(PSTR("IMPORT %d"), dataset_byt);
+			}
+			ArduinoTx_obj.CommitChanges();
+		}
+	}
+	return retval_byt;
+}
+
+// Send the telemetry record of the last frame, see STREAM_START
+// All the values are those of the same frame, as published in the snapshot by callback()
+// Nothing is sent if no frame has been computed since the last record
+void ArduinotxCmd::stream_record() {
+	ArduinotxSnapshot::Snapshot snapshot_obj;
+	if (Snapshot_obj.Read(&snapshot_obj) && snapshot_obj.Frame_lng != StreamFrame_lng) {
+		StreamFrame_lng = snapshot_obj.Frame_lng;
+		byte *record_byt = Frame_byt;
+		*record_byt++ = STREAM_START;
+		*record_byt++ = STREAM_PAYLOAD;
+		for (byte idx_byt = 0; idx_byt < 4; idx_byt++)
+			*record_byt++ = snapshot_obj.Time_lng >> (8 * idx_byt);
+		for (byte idx_byt = 0; idx_byt < NPOTS; idx_byt++) {
+			*record_byt++ = snapshot_obj.Pots_int[idx_byt] & 0xFF;
+			*record_byt++ = snapshot_obj.Pots_int[idx_byt] >> 8;
+		}
+		for (byte chan_byt = 0; chan_byt < CHANNELS; chan_byt++) {
+			*record_byt++ = snapshot_obj.Inputs_int[chan_byt] & 0xFF;
+			*record_byt++ = snapshot_obj.Inputs_int[chan_byt] >> 8;
+		}
+		*record_byt++ = snapshot_obj.Switches_byt;
+		for (byte chan_byt = 0; chan_byt < CHANNELS; chan_byt++) {
+			*record_byt++ = snapshot_obj.Pulses_int[chan_byt] & 0xFF;
+			*record_byt++ = snapshot_obj.Pulses_int[chan_byt] >> 8;
+		}
+		unsigned int checksum_int = Eeprom_obj.Checksum(Frame_byt + 1, 1 + STREAM_PAYLOAD);
+		*record_byt++ = checksum_int & 0xFF;
+		*record_byt++ = checksum_int >> 8;
+		Serial.write(Frame_byt, STREAM_BYTES);
+	}
+}
+
 // Parse number in last char of given word
 // radix_str: the reference string
 // word_str: the string match against the radix
@@ -545,12 +897,16 @@ byte ArduinotxCmd::parse_last_digit(const char *radix_str, const char *word_str)
 	return retval_byt;
 }
 
-// print error message
+// print error message, counted as a rejected line by the upload summary
 void ArduinotxCmd::print_command_error(const char *text_str) {
 	aPrintfln(PSTR("%s: error"), text_str);
+	if (Upload_bool)
+		UploadErrors_int++;
 }
 
 // print error message from PROGMEM
 void ArduinotxCmd::print_command_error_P(PGM_P text_str) {
 	aPrintfln(PSTR("%S: error"), text_str);
+	if (Upload_bool)
+		UploadErrors_int++;
 }
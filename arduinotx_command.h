@@ -19,6 +19,13 @@ Contact information: http://www.reseau.org/arduinorc/index.php?n=Main.Contact
 GS changes: 
 ** 09-10-2015 revised PROGMEM vaiabledefs to latest avr-Compiler (>= 1.6) requirements
 ** 01-11-2016 merged latest version of arduinotx (1.5.5) into arduinodtx
+** 16-10-2026 removed AllVarNames_str[], AllVarTests_byt[], validate_value(): see ArduinotxEeprom::Validate()
+** 16-10-2026 commands EXPORT and IMPORT: binary transfer of a whole block, Frame_byt[]
+** 16-10-2026 commands BAUD and FLOW, upload summary
+** 16-10-2026 command STREAM: telemetry records sent by Refresh()
+** 16-10-2026 DUMP printed by Refresh() as the transmit buffer empties
+** 16-10-2026 commands COPY and DIFF
+** 16-10-2026 abort_import()
 */
 
 
@@ -30,6 +37,32 @@ GS changes:
 
 #define CMDLINESIZE 32
 
+// Binary transfer of a block by EXPORT and IMPORT
+// frame: FRAME_START, block number (0=GLOBAL, or dataset number), VER, block size, block in the layout of the EEProm, checksum
+#define FRAME_START 0x02	// STX
+#define FRAME_HEADER 4
+#define FRAME_TRAILER 2		// Fletcher-16 checksum of the frame without FRAME_START, low byte first, see ArduinotxEeprom::Checksum()
+#define FRAME_BLOCK_BYTES (sizeof(DatasetSettings) > sizeof(GlobalSettings) ? sizeof(DatasetSettings) : sizeof(GlobalSettings))
+#define FRAME_BYTES (FRAME_HEADER + FRAME_BLOCK_BYTES + FRAME_TRAILER)
+#define FRAME_TIMEOUT 1000	// ms, maximum delay between 2 bytes of a frame received by IMPORT
+
+// Telemetry records sent by STREAM ON, built in Frame_byt[]
+// record: STREAM_START, payload size, payload, checksum as in the frames of EXPORT
+// payload, integers low byte first:
+//   time of the frame, millis() (4 bytes)
+//   raw value of each potentiometer [0, 1023] (2 bytes x NPOTS)
+//   input control of each channel [0, 1023], see ArduinoTx::ReadControl() (2 bytes x CHANNELS)
+//   switches, bit 0 = switch 1, 1=HIGH (1 byte)
+//   pulse width of each channel, quarter microseconds (2 bytes x CHANNELS)
+#define STREAM_START 0x01	// SOH
+#define STREAM_PAYLOAD (4 + 2 * NPOTS + 2 * CHANNELS + 1 + 2 * CHANNELS)
+#define STREAM_BYTES (2 + STREAM_PAYLOAD + FRAME_TRAILER)
+#define STREAM_LOAD 75		// highest share of the console bandwidth used by the records, percent
+
+// symbolic values of ImportBlock_byt
+#define IMPORT_NONE 255		// not receiving a frame
+#define IMPORT_ANY 254		// IMPORT without argument: the block number of the frame is used
+
 class ArduinotxCmd {
 	private:
 		typedef enum CmdTokens {
@@ -40,18 +73,53 @@ class ArduinotxCmd {
 			CMD_MODEL,
 			CMD_DUMP,
 			CMD_PRINT,
-			CMD_QMARK // "?" synonym for "PRINT"
+			CMD_QMARK, // "?" synonym for "PRINT"
+			CMD_BENCH,
+			CMD_EXPORT,
+			CMD_IMPORT,
+			CMD_BAUD,
+			CMD_FLOW,
+			CMD_STREAM,
+			CMD_COPY,
+			CMD_DIFF
 		} CmdToken;
 		
 		byte Echo_byt; // b2=echo command prompt, b1=echo replies, b0=echo input characters
+		byte Flow_bool; // true=XOFF sent while a command line is executed, see FLOW
+
+		// upload summary, from ECHO UPLOAD to the next ECHO command
+		byte Upload_bool;
+		unsigned int UploadLines_int;
+		unsigned int UploadErrors_int;
+		unsigned long UploadStart_lng; // millis()
+
+		unsigned long Baudrate_lng; // console baud rate, see BAUD
+
+		// telemetry stream, from STREAM ON to STREAM OFF
+		unsigned int StreamPeriod_int; // ms between 2 records, 0=stream off
+		unsigned long StreamTime_lng; // millis() when the last record was due
+		unsigned long StreamFrame_lng; // frame of the last record sent
+
+		// DUMP or DIFF in progress, printed by Refresh() without waiting for the transmit buffer
+		byte Dump_bool;
+		byte DumpDiff_bool; // true=DIFF, false=DUMP
+		byte DumpDataset_byt;
+		byte DumpChannel_byt;
+		byte DumpReference_byt; // DIFF: dataset compared with, 0=default values
+		int DumpItem_int; // next line, see ArduinotxEeprom::SerializeLine() and ArduinotxEeprom::DiffLine()
+		int DumpLines_int; // lines printed
 
 		static PGM_P const AllCommands_str[] PROGMEM; // Names of all commands
-		static PGM_P const AllVarNames_str[] PROGMEM; // Names of all variables that could be tested by validate_value()
-		static const byte AllVarTests_byt[] PROGMEM; // Test number corresponding to variable name
+		static const unsigned long ConsoleBaudrates_lng[] PROGMEM; // baud rates accepted by BAUD
 		char Cmdline_str[CMDLINESIZE + 1];
+
+		// frame sent by EXPORT, or received after IMPORT, telemetry record, or block copied by COPY
+		byte Frame_byt[FRAME_BYTES];
+		byte FrameLength_byt; // bytes received
+		byte ImportBlock_byt; // block written by the frame received: IMPORT_NONE, IMPORT_ANY, 0=global variables, or dataset number
+		unsigned long FrameTime_lng; // millis() when the last byte was received
 		
 		void serial_prompt();
-		byte validate_value(const char *var_str, int value_int);
 		CmdToken parse_command_line(const char *line_str, char *out_word1_str, char *out_separator_chr, char *out_word2_str);
 		void process_command_line(char *line_str);
 		int parse_potentiometer(char *word_str);
@@ -59,11 +127,19 @@ class ArduinotxCmd {
 		byte parse_last_digit(const char *radix_str, const char *word_str);
 		void print_command_error(const char *text_str);
 		void print_command_error_P(PGM_P text_str);
+		byte parse_block(const char *word_str);
+		byte parse_models(const char *word_str, byte *out_first_byt, byte *out_second_byt);
+		byte export_block(byte dataset_byt);
+		void import_byte(byte read_byt);
+		void abort_import();
+		byte import_frame();
+		void stream_record();
 	
 	public:
 		void InitCommand();
 		void EndCommand();
 		void Input();
+		void Refresh();
 #if MODEL_SWITCH_BEHAVIOUR == MODEL_SWITCH_STEPPING
 		void NextDataset();
 #elif MODEL_SWITCH_BEHAVIOUR == MODEL_SWITCH_ROTATING
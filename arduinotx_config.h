@@ -44,6 +44,10 @@ Contact information: http://www.reseau.org/arduinorc/index.php?n=Main.Contact
 // The buzzer is connected to this pin
 #define BUZZER_PIN 7
 
+// PPM signal (optional) for a classic RF module, generated in parallel with the serial output ; uncomment this line if you implement it
+// The PPM signal is output on pin 10 (OC1B), see ArduinoTx::PPM_PIN
+//#define PPM_ENABLED
+
 // Battery check (optional); comment this line if you do not implement it
 #define BATCHECK_ENABLED
 // Analog pin connected to the 1/2 voltage divider
@@ -80,4 +84,20 @@ Contact information: http://www.reseau.org/arduinorc/index.php?n=Main.Contact
 #define ENDPOINTS_BILINEAR 2	// Option #2: the control stick has no dead-angles: moving it from min to max will output a PPM signal within the endpoints interval. However, the variation rate of the signal in the lower half of the interval will not be the same as in the higher half if CHAN_EPL != CHAN_EPH. This may be acceptable or not.
 #define ENDPOINTS_ALGORITHM ENDPOINTS_BILINEAR
 
+// Baud rate of the console when the command mode starts; the BAUD command changes it until the end of the command mode
+#define CONSOLE_BAUDRATE 2400
+
+// Protocol of the serial link to the servo controller ; you can choose among 2 options:
+#define OUTPUT_PROTOCOL_MINISSC 1	// Option #1: miniSSC II, 8-bit positions, 3 bytes per channel
+#define OUTPUT_PROTOCOL_POLOLU 2	// Option #2: Pololu Maestro compact protocol, quarter-microsecond targets, one packet updates contiguous channels
+#define OUTPUT_PROTOCOL OUTPUT_PROTOCOL_MINISSC
+
+// miniSSC: pulse widths in microseconds corresponding to positions 0 and 254, as configured in the servo controller
+// the pulses of each channel are limited by its PWL and PWH variables, which should be within this range
+#define SSC_PULSE_MIN 720
+#define SSC_PULSE_MAX 2200
+
+// Pololu: the Micro Maestro 6 does not implement Set Multiple Targets, uncomment this line for this controller
+//#define POLOLU_SINGLE_TARGET
+
 #endif
@@ -28,57 +28,104 @@ Contact information: http://www.reseau.org/arduinorc/index.php?n=Main.Contact
 ** GS changes: 
 ** 09-10-2015 revised PROGMEM vaiabledefs to latest avr-Compiler (>= 1.6) requirements
 ** 01-11-2016 merged latest version of arduinotx (1.5.5) into arduinodtx
+** 16-10-2026 VERLIB 16, added global var SBR
+** 16-10-2026 'i' type variables stored as int16_t
+** 16-10-2026 descriptor table AllVars_obj[] replaces the *VarNames_str[], *VarType_byt[], *VarSize_byt[], *VarDefault_int[] arrays,
+**            variables accessed by descriptor index, FindVar(), Validate(), fixed model variables loop in GetDataset()
+** 16-10-2026 GetDataset() reads the whole dataset with eeprom_read_block(), decode_value()
+** 16-10-2026 bytes written by ISR(EE_READY_vect) from a write queue, only if changed: write_byte(), WriteNext()
+** 16-10-2026 CDS written in a wear-leveled log after the last dataset: find_log(), log_write()
+** 16-10-2026 VERLIB 17, checksum of the global variables and of each dataset: CheckBlock(), InitBlock(), update_byte()
+** 16-10-2026 GetGlobal() and GetDataset() read the EEProm block into GlobalSettings and DatasetSettings, no more decoding
+** 16-10-2026 GetBlock() and SetBlock() for the binary transfer of a whole block, validate_values()
+** 16-10-2026 default model name formatted by aSprintf()
+** 16-10-2026 SerializeLine() replaces Serialize(): the dump is printed one line per call
+** 16-10-2026 DiffLine(), default_value(), default_name()
+** 16-10-2026 log_write() rejects a value out of the range of the variable
+** 16-10-2026 CheckEEProm() migrates VERLIB 15: the datasets move after SBR
 */
 
 #include "arduinodtx_transmitter.h"
 #include "arduinotx_eeprom.h"
 #include "arduinotx_lib.h"
+#include "arduinotx_ssc.h"
+#include "arduinotx_hal.h"
+#include <avr/eeprom.h>
+#include <stddef.h>
+
+/* 
+** Variables allocated in arduinodtx.ino  --------------------------------------------
+*/
+
+// EEPROM manager
+extern ArduinotxEeprom Eeprom_obj;
+
+ISR(EE_READY_vect) {
+	Eeprom_obj.WriteNext();
+}
 
 // magic number of this library, tells if the EEProm has been initialized by ArduinotxEeprom::InitEEProm()
 #define IDLIB 55
 // version of this library, used to test if the EEProm contains data from an older version
-#define VERLIB 15
+#define VERLIB 17
 
 /* 
 EEPROM layout for 6 channels
 
 ------------------------ Dataset 0 -----------------------
-0000 - 0039	Global Variables, "LIB" must be at offset 0, "VER" at offset 1
+0000 - 0041	Global Variables, "LIB" must be at offset 0, "VER" at offset 1
 
 ------------------------ Dataset 1 -----------------------
-0040 - 0048	Model Variables (9 bytes)
-0049 - 0056	Mixers Variables ( 2 x 4 bytes)
-0057 - 0128	Channels Variables (6 x 12 bytes)
+0042 - 0050	Model Variables (9 bytes)
+0051 - 0058	Mixers Variables ( 2 x 4 bytes)
+0059 - 0130	Channels Variables (6 x 12 bytes)
 	
 ------------------------ Dataset 2 -----------------------
-0129 - 0137	Model Variables (9 bytes)
-0138 - 0145	Mixers Variables( 2 x 4 bytes)
-0146 - 0217	Channels Variables (6 x 12 bytes)
+0131 - 0139	Model Variables (9 bytes)
+0140 - 0147	Mixers Variables( 2 x 4 bytes)
+0148 - 0219	Channels Variables (6 x 12 bytes)
 ...
 
 EEPROM usage = GLOBAL_BYTES + ( NDATASETS * (BYTES_PER_MODEL + (NMIXERS * BYTES_PER_MIXER) + (CHANNELS * BYTES_PER_CHANNEL)) )
-	6 channels: 9 datasets: 841 bytes	40+ 9 * (9 + (2*4) + (6*12))
-	7 channels: 9 datasets: 949 bytes	40 + 9 * (9 + (2*4) + (7*12))
-	8 channels: 8 datasets: 944 bytes	40 + 8 * (9 + (2*4) + (8*12))
-	9 channels: 7 datasets: 915 bytes	40 + 7 * (9 + (2*4) + (9*12))
+	6 channels: 9 datasets: 843 bytes	42 + 9 * (9 + (2*4) + (6*12))
+	7 channels: 9 datasets: 951 bytes	42 + 9 * (9 + (2*4) + (7*12))
+	8 channels: 8 datasets: 946 bytes	42 + 8 * (9 + (2*4) + (8*12))
+	9 channels: 7 datasets: 917 bytes	42 + 7 * (9 + (2*4) + (9*12))
+
+------------------------ Checksums -----------------------
+0843 - 0862	Checksum of the global variables, then of each dataset (10 x 2 bytes)
+
+------------------------ Log -----------------------------
+0863 - 1023	Log of the VAR_LOGGED global variables (80 entries x 2 bytes)
+
+Each checksum is a Fletcher-16 checksum of the block: low byte = sum of the bytes, high byte = sum of the running sums, modulo 255.
+Since the weight of a byte only depends on its position, SetVar() updates the checksum from the old and new value of each byte.
+
+The VAR_LOGGED variables (CDS) change at each model selection, the log spreads their writes over the remaining EEProm space.
+Each entry is a value byte followed by a header byte: b7 = lap bit, b6-b0 = descriptor index, LOG_FREE if unused.
+The entries are written in sequence and the lap bit is toggled at each pass over the log: the next entry to write is the first one
+whose lap bit differs from the lap bit of the first entry. The latest entry of a variable is found by scanning back from there.
+The value stored at the variable offset in the global variables is only used until the log contains an entry for this variable.
+An erased EEProm (0xFF) is an empty log.
 */
 
 /*
-** Global variables -----------------------------------------------------------
+** Variable descriptors -----------------------------------------------------------
 */
 
-// These variables contain general settings for the whole application, they are not related to any channel
-// Storage: they are stored at the beginning of the EEProm
+// All the variables are described by AllVars_obj[], in this order: global, model, mixer and channel variables.
+// The index of a descriptor in AllVars_obj[] identifies the variable, see VAR_GLOBAL(), VAR_MODEL(), VAR_MIXER(), VAR_CHANNEL() in arduinotx_eeprom.h
+// Offset_byt is the offset of the value in its group, the EEProm address is computed by get_var_offset()
 
+// Global variables: they contain general settings for the whole application, they are not related to any channel
+// Storage: they are stored at the beginning of the EEProm
 // The API considers that global vars belong to dataset #0
-
-// names of global variables (vars that are not related to a channel)
 // LIB	magic number of this library, tells if the EEProm has been initialized by ArduinotxEeprom::InitEEProm()
 // VER	version of the library which has initialized the EEProm
 // CDS	current dataset [1,NDATASETS] ; this is the active, user-selected dataset in the transmitter when the MODEL_SWITCH is opened
 // ADS	alternate dataset [1,NDATASETS], used when the MODEL_SWITCH is closed
 // TSC	throttle cutoff value used by the throttle security check function, [0, 511], default = 50 (1024 * 5% ~ 50)
-// BAT	minimum battery voltage required for Tx operation, ALARM_BATTERY is triggered when voltage gets lower. 
+// BAT	minimum battery voltage required for Tx operation, ALARM_BATTERY is triggered when voltage gets lower.
 //		The voltage is measured at the center of a resistor bridge, so the value  [0, 1023] is an index relative to 50% of the actual battery voltage on a 5 volts scale
 //		The precision of the measurement is affected by the tolerance of the resistors and you may have to calibrate it with a multimeter.
 //		Since a 7805 powers the Tx, the minimal voltage required is 7 volts, leading to the minimum value for BAT = 1023 * (7 / 2) / 5 = 716
@@ -87,301 +134,395 @@ EEPROM usage = GLOBAL_BYTES + ( NDATASETS * (BYTES_PER_MODEL + (NMIXERS * BYTES_
 //		This is why the default value for BAT is 740.
 // KL1...KL8	potentiometer #1 to #8 calibration: the lowest value returned by the analog input connected to this pot [0, 1023]
 // KH1...KH8	potentiometer #1 to #8 calibration: the highest value returned by the analog input connected to this pot [0, 1023]
+// SBR	baud rate of the serial link to the SSC / 100: 96, 192, 384, 576 or 1152, default = 96 (9600 bauds)
+//		use command BENCH to measure the link at each baud rate
 //
-// Allocate Global variables names in PROGMEM
-const char Gvn_LIB[] PROGMEM = "LIB"; const char Gvn_VER[] PROGMEM = "VER"; const char Gvn_CDS[] PROGMEM = "CDS";
-const char Gvn_ADS[] PROGMEM = "ADS"; const char Gvn_TSC[] PROGMEM = "TSC"; const char Gvn_BAT[] PROGMEM = "BAT"; 
-const char Gvn_KL1[] PROGMEM = "KL1"; const char Gvn_KL2[] PROGMEM = "KL2"; const char Gvn_KL3[] PROGMEM = "KL3"; const char Gvn_KL4[] PROGMEM = "KL4"; 
-const char Gvn_KL5[] PROGMEM = "KL5"; const char Gvn_KL6[] PROGMEM = "KL6"; const char Gvn_KL7[] PROGMEM = "KL7"; const char Gvn_KL8[] PROGMEM = "KL8"; 
-const char Gvn_KH1[] PROGMEM = "KH1"; const char Gvn_KH2[] PROGMEM = "KH2"; const char Gvn_KH3[] PROGMEM = "KH3"; const char Gvn_KH4[] PROGMEM = "KH4"; 
-const char Gvn_KH5[] PROGMEM = "KH5"; const char Gvn_KH6[] PROGMEM = "KH6"; const char Gvn_KH7[] PROGMEM = "KH7"; const char Gvn_KH8[] PROGMEM = "KH8"; 
+// Model variables: they contain per-model settings
+// NAM	model name, 8 chars, no spaces; InitEEProm() sets "MODELn"
+// THC	channel number used for throttle control, 0=no throttle channel, default = chan 3
 //
-PGM_P const ArduinotxEeprom::GlobalVarNames_str[] PROGMEM = {
-	Gvn_LIB, Gvn_VER, Gvn_CDS, Gvn_ADS, Gvn_TSC, Gvn_BAT,
-	Gvn_KL1, Gvn_KL2, Gvn_KL3, Gvn_KL4, Gvn_KL5, Gvn_KL6, Gvn_KL7, Gvn_KL8, 
-	Gvn_KH1, Gvn_KH2, Gvn_KH3, Gvn_KH4, Gvn_KH5, Gvn_KH6, Gvn_KH7, Gvn_KH8, 
-	NULL
-};
-
-// type of values of the global variables:
-// a)rray of chars, b)yte, i)nt, s)hort : a short is a signed byte
-const byte ArduinotxEeprom::GlobalVarType_byt[] PROGMEM = {'b','b','b','b','i','i',
-	'i','i','i','i','i','i','i','i','i','i','i','i','i','i','i','i'
-};
-
-// size of values of the global variables
-const byte ArduinotxEeprom::GlobalVarSize_byt[] PROGMEM = {1,1,1,1,2,2,
-	2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2
-};
-
-// default values of the global variables used by InitEEProm()
-const int ArduinotxEeprom::GlobalVarDefault_int[] PROGMEM = {IDLIB, VERLIB, 1, 1, 50, 740,
-	0, 0, 0, 0, 0, 0, 0, 0,
-	1023, 1023, 1023, 1023, 1023, 1023, 1023, 1023
-};
-
-// total size of the values stored in the global variables (sum of GlobalVarSize_byt[])
-#define GLOBAL_BYTES 40
-
-// see also GLOBAL_VARS in arduinotx_eeprom.h
-
-/*
-** Model variables -----------------------------------------------------------
-*/
-// These variables contain per-model settings
-// NAM	model name, 8 chars, no spaces
-// THC	channel number used for throttle control, 0=no throttle channel
-//
-// Allocate Mixer variables base names in PROGMEM
-const char Gvn_NAM[] PROGMEM = "NAM"; const char Gvn_THC[] PROGMEM = "THC"; 
-//
-PGM_P const ArduinotxEeprom::ModelVarNames_str[] PROGMEM = {
-	Gvn_NAM, Gvn_THC,
-	NULL
-};
-
-// type of values of the model variables:
-// a)rray of chars, b)yte, i)nt, s)hort : a short is a signed byte
-const byte ArduinotxEeprom::ModelVarType_byt[] PROGMEM = {'a','b'};
-
-// size of values of the model variables
-const byte ArduinotxEeprom::ModelVarSize_byt[] PROGMEM = {8,1};
-
-// default values of the model variables used by InitEEProm()
-// NAM	a question mark
-// THC	chan 3
-const int ArduinotxEeprom::ModelVarDefault_int[] PROGMEM = {'?', 3};
-
-// total size of the values stored in each model  (sum of ModelVarSize_byt[])
-#define BYTES_PER_MODEL 9
-
-// see also VARS_PER_MODEL and symbolic names defined for the variables indexes in arduinotx_eeprom.h
-
-
-/*
-** Mixer variables -----------------------------------------------------------
-*/
-// These variables contain per-model settings, they define 2 programmable mixers: Mixer1 and Mixer2
+// Mixer variables: they contain per-model settings, they define 2 programmable mixers: Mixer1 and Mixer2
 // Mixer variables, where 'x' is a mixer number [1, 2]
 // N1Mx	input1 potentiometer number [1,8] or 0=none
 // P1Mx 	Percent mix applied to N1Mx [-100, +100]
 // N2Mx	input2 potentiometer number [1,8] or 0=none
 // P2Mx 	Percent mix applied to N2Mx [-100, +100]
 //
-// Allocate Mixer variables base names in PROGMEM
-const char Gvn_N1M[] PROGMEM = "N1M"; const char Gvn_P1M[] PROGMEM = "P1M"; const char Gvn_N2M[] PROGMEM = "N2M"; const char Gvn_P2M[] PROGMEM = "P2M"; 
-//
-PGM_P const ArduinotxEeprom::MixerVarNames_str[] PROGMEM = {
-	Gvn_N1M, Gvn_P1M, Gvn_N2M, Gvn_P2M,
-	NULL
-};
-	
-// type of values of the mixer variables:
-// a)rray of chars, b)yte, i)nt, s)hort : a short is a signed byte
-const byte ArduinotxEeprom::MixerVarType_byt[] PROGMEM = {'b','s','b','s'};
-
-// size of values of the variables in each channel
-const byte ArduinotxEeprom::MixerVarSize_byt[] PROGMEM = {1,1,1,1};
-
-// default values of the variables of each mixer, used by InitEEProm()
-const int ArduinotxEeprom::MixerVarDefault_int[] PROGMEM = {0, 100, 0, 100};
-
-// total size of the values stored in each mixer  (sum of MixerVarSize_byt[])
-#define BYTES_PER_MIXER 4
-
-// see also VARS_PER_MIXER and symbolic names defined for the variables indexes in arduinotx_eeprom.h
-
-
-/*
-** Channel variables -----------------------------------------------------------
-*/
-
-// These variables contain per-channel settings
-// Storage: they are stored after the Model variables
-
+// Channel variables: they contain per-channel settings
+// Storage: they are stored after the Mixer variables
 // Names of variables in each channel, where x is a channel number [1,9]
 // ICTx	input control type: 0=none (slave channel), 1=potentiometer, 2=switch, 3=mixer; see symbolic values of channel variable ICT in arduinotx_eeprom.h
 // ICNx	input control number 0=none, potentiometer number, switch number, mixer number ; potentiometers:[1,8], switch:[1,5], mixer:[1,2]
+//		default: potentiometer having same number as channel
 // REVx	1=reversed, 0=normal
-// DUAx	dual rate reduction percentage applied to the end point values, [0, 100] 
-// EXPx	exponential percentage applied to the input value, [0, 100] 
+// DUAx	dual rate reduction percentage applied to the end point values, [0, 100]
+// EXPx	exponential percentage applied to the input value, [0, 100]
 // PWLx	minimum pulse width acceptable by the servo, microsec
 // PWHx	maximum pulse width acceptable by the servo, microsec
-// EPLx	end point low value, >=MINPW, constrains the minimum pulse width sent to the servo, [0, 100] 
-// EPHx	end point high value, <=MAXPW, constrains the maximum pulse width sent to the servo, [0, 100] 
+// EPLx	end point low value, >=MINPW, constrains the minimum pulse width sent to the servo, [0, 100]
+// EPHx	end point high value, <=MAXPW, constrains the maximum pulse width sent to the servo, [0, 100]
 // SUBx	subtrim centering offset, [-100, 100]
-//
-// Allocate Channel variables base names in PROGMEM
-const char Gvn_ICT[] PROGMEM = "ICT"; const char Gvn_ICN[] PROGMEM = "ICN"; const char Gvn_REV[] PROGMEM = "REV"; 
-const char Gvn_DUA[] PROGMEM = "DUA"; const char Gvn_EXP[] PROGMEM = "EXP"; const char Gvn_PWL[] PROGMEM = "PWL"; const char Gvn_PWH[] PROGMEM = "PWH"; 
-const char Gvn_EPL[] PROGMEM = "EPL"; const char Gvn_EPH[] PROGMEM = "EPH"; const char Gvn_SUB[] PROGMEM = "SUB";
-//
-PGM_P const ArduinotxEeprom::ChanVarNames_str[] PROGMEM = {
-	Gvn_ICT, Gvn_ICN, Gvn_REV, Gvn_DUA, Gvn_EXP, Gvn_PWL, Gvn_PWH, Gvn_EPL, Gvn_EPH, Gvn_SUB,
-	NULL
-};
-
-// type of values of the variables in each channel:
-// a)rray of chars, b)yte, i)nt, s)hort : a short is a signed byte
-const byte ArduinotxEeprom::ChanVarType_byt[] PROGMEM = {'b','b','b','b','b','i','i','b','b','s'};
-
-// size of values of the variables in each channel
-const byte ArduinotxEeprom::ChanVarSize_byt[] PROGMEM = {1,1,1,1,1,2,2,1,1,1};
-
-// Default values of the variables of each channel, used by InitEEProm()
-// Pulse width: these values correspond to the Hextronic HXT500 servo and will accomodate most other servos:
+// Pulse width: the default values correspond to the Hextronic HXT500 servo and will accomodate most other servos:
 // 	PWL: pulse length for 0 degrees in microseconds: 720uS
 // 	PWH: pulse length for 180 degrees in microseconds: 2200uS default for 6 channels, limited to 1700uS for 7-9 channels
 #if CHANNELS <= 6
-const int ArduinotxEeprom::ChanVarDefault_int[] PROGMEM = {1, 0, 0, 100, 0, 720, 2200, 100, 100, 0};
+	#define PWH_DEFAULT 2200
 #else
-const int ArduinotxEeprom::ChanVarDefault_int[] PROGMEM = {1, 0, 0, 100, 0, 720, 1700, 100, 100, 0};
+	#define PWH_DEFAULT 1700
 #endif
 
-// total size of the values stored in each channel  (sum of ChanVarSize_byt[])
-#define BYTES_PER_CHANNEL 12
+static constexpr VarDescriptor AllVars_obj[] PROGMEM = {
+	// name, type, size, offset, flags, min, max, default
+	// global variables
+	{"LIB", 'b', 1, 0, VAR_READONLY, 0, 255, IDLIB},
+	{"VER", 'b', 1, 1, VAR_READONLY, 0, 255, VERLIB},
+	{"CDS", 'b', 1, 2, VAR_LOGGED, 1, NDATASETS, 1},
+	{"ADS", 'b', 1, 3, 0, 1, NDATASETS, 1},
+	{"TSC", 'i', 2, 4, 0, 0, 511, 50},
+	{"BAT", 'i', 2, 6, 0, 0, 1023, 740},
+	{"KL1", 'i', 2, 8, 0, 0, 1023, 0}, {"KL2", 'i', 2, 10, 0, 0, 1023, 0}, {"KL3", 'i', 2, 12, 0, 0, 1023, 0}, {"KL4", 'i', 2, 14, 0, 0, 1023, 0},
+	{"KL5", 'i', 2, 16, 0, 0, 1023, 0}, {"KL6", 'i', 2, 18, 0, 0, 1023, 0}, {"KL7", 'i', 2, 20, 0, 0, 1023, 0}, {"KL8", 'i', 2, 22, 0, 0, 1023, 0},
+	{"KH1", 'i', 2, 24, 0, 0, 1023, 1023}, {"KH2", 'i', 2, 26, 0, 0, 1023, 1023}, {"KH3", 'i', 2, 28, 0, 0, 1023, 1023}, {"KH4", 'i', 2, 30, 0, 0, 1023, 1023},
+	{"KH5", 'i', 2, 32, 0, 0, 1023, 1023}, {"KH6", 'i', 2, 34, 0, 0, 1023, 1023}, {"KH7", 'i', 2, 36, 0, 0, 1023, 1023}, {"KH8", 'i', 2, 38, 0, 0, 1023, 1023},
+	{"SBR", 'i', 2, 40, VAR_BAUDRATE, 96, 1152, 96},
+	// model variables
+	{"NAM", 'a', 8, 0, 0, 0, 0, '?'},
+	{"THC", 'b', 1, 8, 0, 0, CHANNELS, 3},
+	// mixer variables
+	{"N1M", 'b', 1, 0, 0, 0, 8, 0},
+	{"P1M", 's', 1, 1, 0, -100, 100, 100},
+	{"N2M", 'b', 1, 2, 0, 0, 8, 0},
+	{"P2M", 's', 1, 3, 0, -100, 100, 100},
+	// channel variables
+	{"ICT", 'b', 1, 0, 0, 0, 3, ICT_ANALOG},
+	{"ICN", 'b', 1, 1, VAR_DEFAULT_NUMBER, 0, 8, 0},
+	{"REV", 'b', 1, 2, 0, 0, 1, 0},
+	{"DUA", 'b', 1, 3, 0, 0, 100, 100},
+	{"EXP", 'b', 1, 4, 0, 0, 100, 0},
+	{"PWL", 'i', 2, 5, VAR_PULSE_WIDTH, 0, 0, 720},
+	{"PWH", 'i', 2, 7, VAR_PULSE_WIDTH, 0, 0, PWH_DEFAULT},
+	{"EPL", 'b', 1, 9, 0, 0, 100, 100},
+	{"EPH", 'b', 1, 10, 0, 0, 100, 100},
+	{"SUB", 's', 1, 11, 0, -100, 100, 0}
+};
+
+// true if the values of the descriptors [first_byt, last_byt[ follow each other from given offset
+static constexpr bool vars_contiguous(byte first_byt, byte last_byt, byte offset_byt = 0) {
+	return first_byt >= last_byt || (AllVars_obj[first_byt].Offset_byt == offset_byt && vars_contiguous(first_byt + 1, last_byt, offset_byt + AllVars_obj[first_byt].Size_byt));
+}
+
+// total size of the values of the descriptors [first_byt, last_byt[
+static constexpr byte vars_bytes(byte first_byt, byte last_byt) {
+	return AllVars_obj[last_byt - 1].Offset_byt + AllVars_obj[last_byt - 1].Size_byt;
+}
+
+static_assert(sizeof(AllVars_obj) / sizeof(AllVars_obj[0]) == VARS, "AllVars_obj[] must describe GLOBAL_VARS, VARS_PER_MODEL, VARS_PER_MIXER and VARS_PER_CHANNEL variables");
+static_assert(vars_contiguous(VAR_GLOBAL(0), VAR_MODEL(0)), "invalid offset of a global variable");
+static_assert(vars_contiguous(VAR_MODEL(0), VAR_MIXER(0)), "invalid offset of a model variable");
+static_assert(vars_contiguous(VAR_MIXER(0), VAR_CHANNEL(0)), "invalid offset of a mixer variable");
+static_assert(vars_contiguous(VAR_CHANNEL(0), VARS), "invalid offset of a channel variable");
+static_assert(AllVars_obj[VAR_GLOBAL(GLOBAL_LIB)].Offset_byt == 0 && AllVars_obj[VAR_GLOBAL(GLOBAL_VER)].Offset_byt == 1, "LIB must be at offset 0, VER at offset 1, see CheckEEProm()");
+static_assert(AllVars_obj[VAR_MODEL(MOD_NAM)].Size_byt <= MAXSTRLEN, "NAM longer than MAXSTRLEN");
 
-// see also VARS_PER_CHANNEL and symbolic names defined for the variables indexes in arduinotx_eeprom.h
+// total size of the values stored in the global variables, in each model, mixer and channel
+#define GLOBAL_BYTES vars_bytes(VAR_GLOBAL(0), VAR_MODEL(0))
+#define BYTES_PER_MODEL vars_bytes(VAR_MODEL(0), VAR_MIXER(0))
+#define BYTES_PER_MIXER vars_bytes(VAR_MIXER(0), VAR_CHANNEL(0))
+#define BYTES_PER_CHANNEL vars_bytes(VAR_CHANNEL(0), VARS)
 
 #define BYTES_PER_DATASET	(BYTES_PER_MODEL + (NMIXERS * BYTES_PER_MIXER) + (CHANNELS * BYTES_PER_CHANNEL))
 
+// true if the field of a *Settings struct has the offset and size of the value of given variable
+#define SETTINGS_FIELD(settings, field, id) (offsetof(settings, field) == AllVars_obj[id].Offset_byt && sizeof(((settings *)0)->field) == AllVars_obj[id].Size_byt)
+
+static_assert(sizeof(GlobalSettings) == GLOBAL_BYTES, "GlobalSettings must have the layout of the global variables");
+static_assert(SETTINGS_FIELD(GlobalSettings, Lib_byt, VAR_GLOBAL(GLOBAL_LIB)) && SETTINGS_FIELD(GlobalSettings, Ver_byt, VAR_GLOBAL(GLOBAL_VER))
+	&& SETTINGS_FIELD(GlobalSettings, Cds_byt, VAR_GLOBAL(GLOBAL_CDS)) && SETTINGS_FIELD(GlobalSettings, Ads_byt, VAR_GLOBAL(GLOBAL_ADS))
+	&& SETTINGS_FIELD(GlobalSettings, Tsc_int, VAR_GLOBAL(GLOBAL_TSC)) && SETTINGS_FIELD(GlobalSettings, Bat_int, VAR_GLOBAL(GLOBAL_BAT))
+	&& SETTINGS_FIELD(GlobalSettings, Cal_int[CAL_LOW][0], VAR_GLOBAL(GLOBAL_KL1)) && SETTINGS_FIELD(GlobalSettings, Cal_int[CAL_HIGH][0], VAR_GLOBAL(GLOBAL_KH1))
+	&& SETTINGS_FIELD(GlobalSettings, Sbr_int, VAR_GLOBAL(GLOBAL_SBR)), "invalid field of GlobalSettings");
+static_assert(sizeof(ModelSettings) == BYTES_PER_MODEL && SETTINGS_FIELD(ModelSettings, Nam_chr, VAR_MODEL(MOD_NAM)) && SETTINGS_FIELD(ModelSettings, Thc_byt, VAR_MODEL(MOD_THC)),
+	"ModelSettings must have the layout of the model variables");
+static_assert(sizeof(MixerSettings) == BYTES_PER_MIXER && SETTINGS_FIELD(MixerSettings, N1m_byt, VAR_MIXER(MIX_N1M)) && SETTINGS_FIELD(MixerSettings, P1m_chr, VAR_MIXER(MIX_P1M))
+	&& SETTINGS_FIELD(MixerSettings, N2m_byt, VAR_MIXER(MIX_N2M)) && SETTINGS_FIELD(MixerSettings, P2m_chr, VAR_MIXER(MIX_P2M)),
+	"MixerSettings must have the layout of the mixer variables");
+static_assert(sizeof(ChannelSettings) == BYTES_PER_CHANNEL && SETTINGS_FIELD(ChannelSettings, Ict_byt, VAR_CHANNEL(CHAN_ICT)) && SETTINGS_FIELD(ChannelSettings, Icn_byt, VAR_CHANNEL(CHAN_ICN))
+	&& SETTINGS_FIELD(ChannelSettings, Rev_byt, VAR_CHANNEL(CHAN_REV)) && SETTINGS_FIELD(ChannelSettings, Dua_byt, VAR_CHANNEL(CHAN_DUA))
+	&& SETTINGS_FIELD(ChannelSettings, Exp_byt, VAR_CHANNEL(CHAN_EXP)) && SETTINGS_FIELD(ChannelSettings, Pwl_int, VAR_CHANNEL(CHAN_PWL))
+	&& SETTINGS_FIELD(ChannelSettings, Pwh_int, VAR_CHANNEL(CHAN_PWH)) && SETTINGS_FIELD(ChannelSettings, Epl_byt, VAR_CHANNEL(CHAN_EPL))
+	&& SETTINGS_FIELD(ChannelSettings, Eph_byt, VAR_CHANNEL(CHAN_EPH)) && SETTINGS_FIELD(ChannelSettings, Sub_chr, VAR_CHANNEL(CHAN_SUB)),
+	"ChannelSettings must have the layout of the channel variables");
+static_assert(sizeof(DatasetSettings) == BYTES_PER_DATASET, "DatasetSettings must have the layout of a dataset");
+
+// number of variables of given type in the descriptors [first_byt, last_byt[
+static constexpr byte vars_typed(byte first_byt, byte last_byt, char type_chr) {
+	return first_byt >= last_byt ? 0 : (AllVars_obj[first_byt].Type_chr == type_chr ? 1 : 0) + vars_typed(first_byt + 1, last_byt, type_chr);
+}
+
+static_assert(vars_typed(0, VARS, 's') == 3 && AllVars_obj[VAR_MIXER(MIX_P1M)].Type_chr == 's' && AllVars_obj[VAR_MIXER(MIX_P2M)].Type_chr == 's' && AllVars_obj[VAR_CHANNEL(CHAN_SUB)].Type_chr == 's',
+	"GetDataset() converts P1M, P2M and SUB only");
+static_assert(vars_typed(VAR_MODEL(0), VARS, 'a') == 1 && AllVars_obj[VAR_MODEL(MOD_NAM)].Type_chr == 'a', "DiffLine() compares NAM with default_name() only");
+
+// number of variables in a dataset, counting each mixer and each channel
+#define DATASET_VARS (VARS_PER_MODEL + NMIXERS * VARS_PER_MIXER + CHANNELS * VARS_PER_CHANNEL)
+
+// Checksums of the global variables (block 0) and of each dataset (block n), see "EEPROM layout"
+#define CHECK_OFFSET (GLOBAL_BYTES + NDATASETS * BYTES_PER_DATASET)
+#define CHECK_BYTES (2 * (NDATASETS + 1))
+
+// size of given block: 0=global variables, or dataset number [1, NDATASETS]
+#define BLOCK_BYTES(dataset) ((dataset) == 0 ? GLOBAL_BYTES : BYTES_PER_DATASET)
+
+// Log of the VAR_LOGGED variables, see "EEPROM layout"
+#define LOG_OFFSET (CHECK_OFFSET + CHECK_BYTES)
+#define LOG_ENTRY_BYTES 2
+#define LOG_ENTRIES ((E2END + 1 - LOG_OFFSET) / LOG_ENTRY_BYTES)
+#define LOG_LAP 0x80		// lap bit of the header
+#define LOG_FREE 0x7F		// descriptor index of an unused entry
+#define LOG_NONE 255		// no entry in LogLatest_byt[]
+
+// number of descriptors having given flag among the descriptors [first_byt, last_byt[
+static constexpr byte vars_flagged(byte first_byt, byte last_byt, byte flag_byt) {
+	return first_byt >= last_byt ? 0 : ((AllVars_obj[first_byt].Flags_byt & flag_byt) ? 1 : 0) + vars_flagged(first_byt + 1, last_byt, flag_byt);
+}
+
+// true if all the VAR_LOGGED variables among the descriptors [first_byt, last_byt[ are 'b'-type global variables
+static constexpr bool logged_vars_valid(byte first_byt, byte last_byt) {
+	return first_byt >= last_byt || ((!(AllVars_obj[first_byt].Flags_byt & VAR_LOGGED) || (first_byt < VAR_MODEL(0) && AllVars_obj[first_byt].Type_chr == 'b')) && logged_vars_valid(first_byt + 1, last_byt));
+}
+
+static_assert(vars_flagged(0, VARS, VAR_LOGGED) == LOG_VARS, "LOG_VARS must be the number of VAR_LOGGED variables");
+static_assert(logged_vars_valid(0, VARS), "VAR_LOGGED variables must be 'b'-type global variables");
+static_assert(LOG_ENTRIES >= 8 && LOG_ENTRIES < LOG_NONE, "no room for the log after the last dataset");
+
+// offset in the EEProm of given dataset [1, NDATASETS]
+#define DATASET_OFFSET(dataset) (GLOBAL_BYTES + ((dataset) - 1) * BYTES_PER_DATASET)
+
+// VERLIB 15: the global variables end before SBR, the datasets follow, no checksums and no log, see CheckEEProm()
+#define GLOBAL_BYTES_V15 40
+static_assert(AllVars_obj[VAR_GLOBAL(GLOBAL_SBR)].Offset_byt == GLOBAL_BYTES_V15 && VAR_GLOBAL(GLOBAL_SBR) + 1 == VAR_MODEL(0), "VERLIB 15 has the global variables before SBR");
+
 /*
 ** Public interface
 */
 
 // Set default values of all variables
 void ArduinotxEeprom::InitEEProm() {
-	char var_str[MAXVARNAME + 1];
-	char name_str[MAXSTRLEN + 1]; // at least MAXVARNAME + 2, but we also use this buffer to format the model name string value
-	
-	// for each global variable
-	for (byte idx_byt = 0; idx_byt < GLOBAL_VARS; idx_byt++) {
-		getProgmemStrArrayValue(var_str, GlobalVarNames_str, idx_byt, MAXVARNAME + 1);
-		SetVar(0, var_str, getProgmemIntArrayValue(GlobalVarDefault_int, idx_byt));
-		//aPrintfln(PSTR("%s default=%d"), var_str, getProgmemIntArrayValue(GlobalVarDefault_int, idx_byt));
+	VarDescriptor var_obj;
+	for (byte ds_byt = 0; ds_byt <= NDATASETS; ds_byt++)
+		InitBlock(ds_byt);
+	// the VAR_LOGGED variables are not part of the global block
+	for (byte id_byt = VAR_GLOBAL(0); id_byt < VAR_MODEL(0); id_byt++) {
+		get_descriptor(id_byt, &var_obj);
+		if (var_obj.Flags_byt & VAR_LOGGED)
+			SetVar(0, id_byt, 0, var_obj.Default_int);
 	}
+}
+
+// Set default values of the variables of given block and compute its checksum
+// dataset_byt: 0=global variables, or dataset number [1, NDATASETS]
+void ArduinotxEeprom::InitBlock(byte dataset_byt) {
+	VarDescriptor var_obj;
+	char name_str[MAXSTRLEN + 1]; // to format the model name string value
 
-	// for each data set
-	for (byte ds_byt = 1; ds_byt <= NDATASETS; ds_byt++) {
-		
+	if (dataset_byt == 0) {
+		// for each global variable, the VAR_LOGGED variables keep their latest value in the log
+		for (byte id_byt = VAR_GLOBAL(0); id_byt < VAR_MODEL(0); id_byt++) {
+			get_descriptor(id_byt, &var_obj);
+			if (!(var_obj.Flags_byt & VAR_LOGGED))
+				SetVar(0, id_byt, 0, var_obj.Default_int);
+		}
+	}
+	else if (dataset_byt <= NDATASETS) {
 		// model variables
-		for (byte idx_byt = 0; idx_byt < VARS_PER_MODEL; idx_byt++) {
-			getProgmemStrArrayValue(var_str, ModelVarNames_str, idx_byt, MAXVARNAME + 1);
-			SetVar(ds_byt, var_str, getProgmemIntArrayValue(ModelVarDefault_int, idx_byt));
+		for (byte id_byt = VAR_MODEL(0); id_byt < VAR_MIXER(0); id_byt++) {
+			get_descriptor(id_byt, &var_obj);
+			SetVar(dataset_byt, id_byt, 0, var_obj.Default_int);
 		}
 		// set the model name
-		sprintf(name_str, "MODEL%d", ds_byt);
-		SetVar(ds_byt, "NAM", 0, name_str);
-		
+		default_name(dataset_byt, name_str);
+		SetVar(dataset_byt, VAR_MODEL(MOD_NAM), 0, 0, name_str);
+
 		// for each mixer
 		for (byte mixer_byt = 1; mixer_byt <= NMIXERS; mixer_byt++) {
 			// for each mixer variable
-			for (byte idx_byt = 0; idx_byt < VARS_PER_MIXER; idx_byt++) {
-				getProgmemStrArrayValue(var_str, MixerVarNames_str, idx_byt, MAXVARNAME + 1);
-				format_variable_name(var_str, mixer_byt, name_str);
-				SetVar(ds_byt, name_str, getProgmemIntArrayValue(MixerVarDefault_int, idx_byt));
+			for (byte id_byt = VAR_MIXER(0); id_byt < VAR_CHANNEL(0); id_byt++) {
+				get_descriptor(id_byt, &var_obj);
+				SetVar(dataset_byt, id_byt, mixer_byt, var_obj.Default_int);
 			}
 		}
-		
+
 		// for each channel
 		for (byte chan_byt = 1; chan_byt <= CHANNELS; chan_byt++) {
 			// for each channel variable
-			for (byte idx_byt = 0; idx_byt < VARS_PER_CHANNEL; idx_byt++) {
-				int value_int = getProgmemIntArrayValue(ChanVarDefault_int, idx_byt);
-				getProgmemStrArrayValue(var_str, ChanVarNames_str, idx_byt, MAXVARNAME + 1);
-				if (strcmp(var_str, "ICN") == 0)
-					value_int = chan_byt ; // default: potentiometer having same number as channel
-				format_variable_name(var_str, chan_byt, name_str);
-				SetVar(ds_byt, name_str, value_int);
-			}
+			for (byte id_byt = VAR_CHANNEL(0); id_byt < VARS; id_byt++)
+				SetVar(dataset_byt, id_byt, chan_byt, default_value(id_byt, chan_byt));
 		}
 	}
+	else
+		return;
+	// the previous checksum was not valid if the block was not initialized
+	store_checksum(dataset_byt, block_checksum(dataset_byt));
+}
+
+// Test the checksum of given block
+// dataset_byt: 0=global variables, or dataset number [1, NDATASETS]
+// return value: 0=ok, 1=checksum error or invalid dataset
+byte ArduinotxEeprom::CheckBlock(byte dataset_byt) {
+	byte retval_byt = 1;
+	if (dataset_byt <= NDATASETS && block_checksum(dataset_byt) == read_checksum(dataset_byt))
+		retval_byt = 0;
+	return retval_byt;
 }
 
-// check if the EEProm contains valid data
+// check if the EEProm contains valid data, an EEProm of VERLIB 15 or 16 is converted first
 // return value: >0=EEPROM is Ok and returns total size of data stored in EEPROM; -1 EEProm is not initialized
 int ArduinotxEeprom::CheckEEProm() {
 	int retval_int = -1;
-	if (EEPROM.read(0) == IDLIB && EEPROM.read(1) == VERLIB)
+	byte version_byt = read_byte(1);
+	if (read_byte(0) == IDLIB && (version_byt == VERLIB - 1 || version_byt == VERLIB - 2)) {
+		if (version_byt == VERLIB - 2) {
+			// VERLIB 15 has no SBR: the datasets move up by the size of SBR, starting from the last byte
+			for (int offset_int = GLOBAL_BYTES_V15 + NDATASETS * BYTES_PER_DATASET - 1; offset_int >= GLOBAL_BYTES_V15; offset_int--)
+				write_byte(offset_int + GLOBAL_BYTES - GLOBAL_BYTES_V15, read_byte(offset_int));
+			SetVar(0, VAR_GLOBAL(GLOBAL_SBR), 0, (int)pgm_read_word(&AllVars_obj[VAR_GLOBAL(GLOBAL_SBR)].Default_int));
+		}
+		else
+			find_log(CHECK_OFFSET); // VERLIB 16 has the same variables without checksums, its log starts at CHECK_OFFSET
+		byte logged_byt[LOG_VARS] = {0};
+		for (byte id_byt = VAR_GLOBAL(0); id_byt < VAR_MODEL(0); id_byt++) {
+			if (pgm_read_byte(&AllVars_obj[id_byt].Flags_byt) & VAR_LOGGED) {
+				byte entry_byt = version_byt == VERLIB - 1 ? LogLatest_byt[log_slot(id_byt)] : LOG_NONE; // VERLIB 15 has no log
+				// no entry in the log: the value is still at the offset of the variable, as read by GetVar()
+				logged_byt[log_slot(id_byt)] = entry_byt == LOG_NONE ? read_byte(pgm_read_byte(&AllVars_obj[id_byt].Offset_byt)) : read_byte(CHECK_OFFSET + entry_byt * LOG_ENTRY_BYTES);
+			}
+		}
+		for (byte ds_byt = 0; ds_byt <= NDATASETS; ds_byt++)
+			store_checksum(ds_byt, block_checksum(ds_byt));
+		// the checksums have overwritten the first entries of the old log
+		LogFound_bool = false;
+		for (byte id_byt = VAR_GLOBAL(0); id_byt < VAR_MODEL(0); id_byt++) {
+			if ((pgm_read_byte(&AllVars_obj[id_byt].Flags_byt) & VAR_LOGGED) && log_write(id_byt, logged_byt[log_slot(id_byt)]) != 0)
+				log_write(id_byt, (int)pgm_read_word(&AllVars_obj[id_byt].Default_int)); // out of range
+		}
+		SetVar(0, VAR_GLOBAL(GLOBAL_VER), 0, VERLIB);
+	}
+	if (read_byte(0) == IDLIB && read_byte(1) == VERLIB)
 		retval_int = GLOBAL_BYTES + (NDATASETS * BYTES_PER_DATASET);
 	return retval_int;
 }
 
-// test if given variable exists
+// Find the variable having given name: name of global or model variable, or VARn where n=channel number or mixer number
+// This is the only function that parses variable names, the other functions use the descriptor index
 // return value: 1=ok, 0=var not found
-byte ArduinotxEeprom::IsVar(byte dataset_byt, const char *var_str) {
-	byte retval_byt = 0;
-	byte size_byt = 0;
-	char type_chr = ' ';
-	int offset_int = get_var_offset(dataset_byt, var_str, &size_byt, &type_chr);
-	if (offset_int >= 0)
-		retval_byt = 1;
-	return retval_byt;
+byte ArduinotxEeprom::FindVar(const char *name_str, VarRef *out_ref) {
+	byte first_byt = VARS;
+	byte last_byt = VARS;
+	byte number_byt = 0;
+	int namelen_int = strlen(name_str);
+	if (namelen_int == MAXVARNAME) {
+		// global or model variable
+		first_byt = VAR_GLOBAL(0);
+		last_byt = VAR_MIXER(0);
+	}
+	else if (namelen_int == MAXVARNAME + 1 && name_str[MAXVARNAME] >= '1' && name_str[MAXVARNAME] <= '9') {
+		// mixer or channel variable, the last character is the mixer or channel number: eg "N1M1", "ICT1"
+		number_byt = name_str[MAXVARNAME] - '0';
+		first_byt = (number_byt <= NMIXERS) ? VAR_MIXER(0) : VAR_CHANNEL(0);
+		last_byt = (number_byt <= CHANNELS) ? VARS : VAR_CHANNEL(0);
+	}
+	for (byte id_byt = first_byt; id_byt < last_byt; id_byt++) {
+		if (strncmp_P(name_str, AllVars_obj[id_byt].Name_str, MAXVARNAME) == 0) {
+			out_ref->Id_byt = id_byt;
+			out_ref->Number_byt = number_byt;
+			return 1;
+		}
+	}
+	return 0;
+}
+
+// Copy the name of given variable into given buffer, at least MAXVARNAME + 2 bytes
+// number_byt: mixer or channel number appended to the name, 0 for global and model variables
+void ArduinotxEeprom::GetName(byte id_byt, byte number_byt, char *out_name_str) {
+	strncpy_P(out_name_str, AllVars_obj[id_byt].Name_str, MAXVARNAME + 1);
+	if (number_byt) {
+		out_name_str[MAXVARNAME] = '0' + number_byt;
+		out_name_str[MAXVARNAME + 1] = '\0';
+	}
 }
 
 // Retrieve the type of given variable:
 // Return value: a)rray of chars, b)yte, i)nt, s)hort : a short is a signed byte, '?' = variable not found
-char ArduinotxEeprom::GetType(byte dataset_byt, const char *var_str) {
-	char retval_chr;
-	byte size_byt = 0;
-	int offset_int = get_var_offset(dataset_byt, var_str, &size_byt, &retval_chr);
-	if (offset_int < 0)
-		retval_chr = '?';
+char ArduinotxEeprom::GetType(byte id_byt) {
+	char retval_chr = '?';
+	if (id_byt < VARS)
+		retval_chr = pgm_read_byte(&AllVars_obj[id_byt].Type_chr);
 	return retval_chr;
 }
 
-// Retrieve the numerical value of given 'b', 's', 'i'-type variable
-// dataset_int: 0=global variable, or dataset number [1, NDATASETS]
-// var_str: name of global or model variable, or VARn where n=channel number or mixer number
-// Return value: the numerical value of the variable, or -1 on invalid name or invalid dataset or invalid variable type
-int ArduinotxEeprom::GetVar(byte dataset_byt, const char *var_str) {
-	int retval_int = -1;
-	byte size_byt = 0;
-	char type_chr = ' ';
-	int offset_int = get_var_offset(dataset_byt, var_str, &size_byt, &type_chr);
-	if (offset_int >= 0) {
-		switch (type_chr) {
-			case 'b':
-				retval_int = EEPROM.read(offset_int);
-				break;
-			
-			case 's':
-				retval_int = EEPROM.read(offset_int);
-				retval_int = short_to_int(retval_int);
-				break;
-			
-			case 'i': {
-				union bytes_int {
-					byte value_byt[2];
-					int value_int;
-				} buffer_uni;
-				for (byte idx_byt = 0; idx_byt < size_byt; idx_byt++) {
-					buffer_uni.value_byt[idx_byt] = EEPROM.read(offset_int + idx_byt);
+// Test if given variable is a global variable, stored in dataset 0
+byte ArduinotxEeprom::IsGlobal(byte id_byt) {
+	return id_byt < VAR_MODEL(0);
+}
+
+// Test if given numerical value can be set by a command in given variable
+// Return value: 0=valid, 1=out of range or read-only variable
+byte ArduinotxEeprom::Validate(byte id_byt, int value_int) {
+	byte retval_byt = 1;
+	if (id_byt < VARS) {
+		VarDescriptor var_obj;
+		get_descriptor(id_byt, &var_obj);
+		if (var_obj.Flags_byt & VAR_PULSE_WIDTH) {
+			var_obj.Min_int = ArduinoTx::PPM_LOW;
+			var_obj.Max_int = 10 * ArduinoTx::PPM_LOW;
+		}
+		if (!(var_obj.Flags_byt & VAR_READONLY) && value_int >= var_obj.Min_int && value_int <= var_obj.Max_int) {
+			retval_byt = 0;
+			if (var_obj.Flags_byt & VAR_BAUDRATE) {
+				// one of ArduinotxSsc::Baudrates_int[]
+				retval_byt = 1;
+				for (byte idx_byt = 0; idx_byt < SSC_BAUDRATES; idx_byt++) {
+					if (value_int == (int)pgm_read_word(&ArduinotxSsc::Baudrates_int[idx_byt]))
+						retval_byt = 0;
 				}
-				retval_int = buffer_uni.value_int;
-				break;
 			}
 		}
 	}
+	return retval_byt;
+}
+
+// Retrieve the numerical value of given 'b', 's', 'i'-type variable
+// dataset_byt: 0=global variable, or dataset number [1, NDATASETS]
+// id_byt: descriptor index of the variable
+// number_byt: mixer or channel number, 0 for global and model variables
+// Return value: the numerical value of the variable, or -1 on invalid variable or invalid dataset or invalid variable type
+int ArduinotxEeprom::GetVar(byte dataset_byt, byte id_byt, byte number_byt) {
+	int retval_int = -1;
+	VarDescriptor var_obj;
+	int offset_int = get_var_offset(dataset_byt, id_byt, number_byt, &var_obj);
+	if (offset_int >= 0 && var_obj.Type_chr != 'a') {
+		byte value_byt[2];
+		read_block(value_byt, offset_int, var_obj.Size_byt);
+		retval_int = decode_value(value_byt, &var_obj);
+	}
 	return retval_int;
 }
 
-		
+
 // Copy the string value of given 'a'-type variable into given buffer
-// dataset_int: 0=global variable, or dataset number [1, NDATASETS]
-// var_str: name of global or model variable, or VARn where n=channel number or mixer number
+// dataset_byt: 0=global variable, or dataset number [1, NDATASETS]
+// id_byt: descriptor index of the variable
+// number_byt: mixer or channel number, 0 for global and model variables
 // out_value_str: user-allocated buffer where the string value will be copied; the terminating spaces will be stripped, a '\0' will be appended
-// Return value: length of the string value (without the terminating spaces which have been stripped) , or -1 on invalid name or invalid dataset
-int ArduinotxEeprom::GetVar(byte dataset_byt, const char *var_str, char *out_value_str) {
+// Return value: length of the string value (without the terminating spaces which have been stripped) , or -1 on invalid variable or invalid dataset
+int ArduinotxEeprom::GetVar(byte dataset_byt, byte id_byt, byte number_byt, char *out_value_str) {
 	int retval_int = -1;
-	byte size_byt = 0;
-	char type_chr = ' ';
-	int offset_int = get_var_offset(dataset_byt, var_str, &size_byt, &type_chr);
+	VarDescriptor var_obj;
+	int offset_int = get_var_offset(dataset_byt, id_byt, number_byt, &var_obj);
 	if (offset_int >= 0) {
-		if (type_chr == 'a') {
-			for (byte idx_byt = 0; idx_byt < size_byt; idx_byt++)
-				*(out_value_str + idx_byt) = EEPROM.read(offset_int + idx_byt);
-			*(out_value_str + size_byt) = '\0';
+		if (var_obj.Type_chr == 'a') {
+			read_block((byte *)out_value_str, offset_int, var_obj.Size_byt);
+			*(out_value_str + var_obj.Size_byt) = '\0';
 		}
 		Trimwhitespace(out_value_str);
 		retval_int = strlen(out_value_str);
@@ -389,60 +530,62 @@ int ArduinotxEeprom::GetVar(byte dataset_byt, const char *var_str, char *out_val
 	return retval_int;
 }
 
-// Set the value of given variable, or 0 on invalid name or invalid dataset
-// dataset_int: 0=global variable, or dataset number [1, NDATASETS]
-// var_str: name of global or model variable, or VARn where n=channel number or mixer number
+// Set the value of given variable
+// dataset_byt: 0=global variable, or dataset number [1, NDATASETS]
+// id_byt: descriptor index of the variable
+// number_byt: mixer or channel number, 0 for global and model variables
 // value_int : set this value for 'b', 'i', 's' types
 // value_str : set this value for 'a' type; if NULL then fill the array with value_int characters
 // return value: 0=Ok, 1=error
-byte ArduinotxEeprom::SetVar(byte dataset_byt, const char *var_str, int value_int, const char *value_str) {
+byte ArduinotxEeprom::SetVar(byte dataset_byt, byte id_byt, byte number_byt, int value_int, const char *value_str) {
 	byte retval_byt = 0;
-	byte size_byt = 0;
-	char type_chr = ' ';
-	int offset_int = get_var_offset(dataset_byt, var_str, &size_byt, &type_chr);
-	if (offset_int >= 0) {
-		switch (type_chr) {
+	VarDescriptor var_obj;
+	int offset_int = get_var_offset(dataset_byt, id_byt, number_byt, &var_obj);
+	if (offset_int >= 0 && (var_obj.Flags_byt & VAR_LOGGED))
+		retval_byt = log_write(id_byt, value_int);
+	else if (offset_int >= 0) {
+		switch (var_obj.Type_chr) {
 			case 'a':
 				if (value_str) {
 					char next_chr;
 					byte end_byt = 0;
-					for (byte idx_byt = 0; idx_byt < size_byt; idx_byt++) {
+					for (byte idx_byt = 0; idx_byt < var_obj.Size_byt; idx_byt++) {
 						if (!end_byt) {
 							next_chr = *(value_str+idx_byt);
 							if (next_chr == '\0')
 								end_byt = 1;
 						}
 						if (end_byt)
-							next_chr = ' '; // append spaces if value_str is shorter than size_byt
-						EEPROM.write(offset_int + idx_byt, next_chr);
+							next_chr = ' '; // append spaces if value_str is shorter than Size_byt
+						update_byte(offset_int + idx_byt, next_chr);
 					}
 				}
 				else {
 					// fill the string with value_int characters
-					for (byte idx_byt = 0; idx_byt < size_byt; idx_byt++) {
-						EEPROM.write(offset_int + idx_byt, (char)value_int);
+					for (byte idx_byt = 0; idx_byt < var_obj.Size_byt; idx_byt++) {
+						update_byte(offset_int + idx_byt, (char)value_int);
 					}
 				}
 				break;
-				
+
 			case 'b':
-				EEPROM.write(offset_int, value_int);
+				update_byte(offset_int, value_int);
 				break;
-			
+
 			case 'i': {
 				union bytes_int {
 					byte value_byt[2];
-					int value_int;
+					int16_t value_int; // 2 bytes, also when int is larger (host build)
 				} buffer_uni;
 				buffer_uni.value_int = value_int;
-				for (byte idx_byt = 0; idx_byt < size_byt; idx_byt++) {
-					EEPROM.write(offset_int + idx_byt, buffer_uni.value_byt[idx_byt]);
+				for (byte idx_byt = 0; idx_byt < var_obj.Size_byt; idx_byt++) {
+					update_byte(offset_int + idx_byt, buffer_uni.value_byt[idx_byt]);
 				}
 				break;
 			}
-			
+
 			case 's':
-				EEPROM.write(offset_int,  int_to_short(value_int));
+				update_byte(offset_int,  int_to_short(value_int));
 				break;
 		}
 	}
@@ -451,113 +594,296 @@ byte ArduinotxEeprom::SetVar(byte dataset_byt, const char *var_str, int value_in
 	return retval_byt;
 }
 
-// Load global variables into given array
-void ArduinotxEeprom::GetGlobal(int out_global_int[]) {
-	char name_str[MAXVARNAME + 1];
-	// for each variable
-	for (byte idx_byt = 0; idx_byt < GLOBAL_VARS; idx_byt++) {
-		getProgmemStrArrayValue(name_str, GlobalVarNames_str, idx_byt, MAXVARNAME + 1);
-		out_global_int[idx_byt] = GetVar(0, name_str);
-	}
+// Load global variables into given struct
+// return value: 0=ok, 2=checksum error
+byte ArduinotxEeprom::GetGlobal(GlobalSettings *out_global_obj) {
+	return GetBlock(0, (byte *)out_global_obj);
 }
 
-// Load given dataset data into given arrays
-// return value: 0=ok, 1=invalid dataset
-byte ArduinotxEeprom::GetDataset(byte dataset_byt, int out_model_int[], int out_mixers_int[][VARS_PER_MIXER], int out_channels_int[][VARS_PER_CHANNEL]) {
+// Load given dataset into given struct
+// The dataset is read from the EEProm in a single block, its layout is the layout of DatasetSettings; the 's'-type values are then converted to int8_t
+// return value: 0=ok, 1=invalid dataset, 2=checksum error
+byte ArduinotxEeprom::GetDataset(byte dataset_byt, DatasetSettings *out_dataset_obj) {
 	byte retval_byt = 0;
-	char var_str[MAXVARNAME + 1];
-	char name_str[MAXVARNAME + 2];
 	if (dataset_byt > 0 && dataset_byt <= NDATASETS) {
-		
-		// model variables
-		for (byte idx_byt = 0; idx_byt < VARS_PER_MIXER; idx_byt++) {
-			getProgmemStrArrayValue(var_str, ModelVarNames_str, idx_byt, MAXVARNAME + 1);
-			out_model_int[idx_byt] = GetVar(dataset_byt, var_str); // GetVar() returns -1 for string variables
+		retval_byt = GetBlock(dataset_byt, (byte *)out_dataset_obj);
+		// 's'-type values are stored with an offset of 128, see short_to_int()
+		for (byte mixer_byt = 0; mixer_byt < NMIXERS; mixer_byt++) {
+			MixerSettings *mixer_ptr = &out_dataset_obj->Mixers_obj[mixer_byt];
+			mixer_ptr->P1m_chr = short_to_int((byte)mixer_ptr->P1m_chr);
+			mixer_ptr->P2m_chr = short_to_int((byte)mixer_ptr->P2m_chr);
 		}
+		for (byte chan_byt = 0; chan_byt < CHANNELS; chan_byt++)
+			out_dataset_obj->Channels_obj[chan_byt].Sub_chr = short_to_int((byte)out_dataset_obj->Channels_obj[chan_byt].Sub_chr);
+	}
+	else
+		retval_byt = 1; // invalid dataset
+	return retval_byt;
+}
 
-		// for each mixer
-		for (byte mixer_byt = 1; mixer_byt <= NMIXERS; mixer_byt++) {
-			// for each variable
-			for (byte idx_byt = 0; idx_byt < VARS_PER_MIXER; idx_byt++) {
-				getProgmemStrArrayValue(var_str, MixerVarNames_str, idx_byt, MAXVARNAME + 1);
-				format_variable_name(var_str, mixer_byt, name_str);
-				out_mixers_int[mixer_byt - 1][idx_byt] = GetVar(dataset_byt, name_str);
+// Return the size of given block: 0=global variables, or dataset number [1, NDATASETS]; 0 on invalid dataset
+byte ArduinotxEeprom::BlockSize(byte dataset_byt) {
+	return dataset_byt <= NDATASETS ? BLOCK_BYTES(dataset_byt) : 0;
+}
+
+// Read given block as it is stored in the EEProm, BlockSize() bytes
+// The VAR_LOGGED variables of the global block are replaced by their latest value in the log
+// dataset_byt: 0=global variables, or dataset number [1, NDATASETS]
+// return value: 0=ok, 1=invalid dataset, 2=checksum error
+byte ArduinotxEeprom::GetBlock(byte dataset_byt, byte *out_block_byt) {
+	byte retval_byt = 1;
+	if (dataset_byt <= NDATASETS) {
+		read_block(out_block_byt, dataset_byt == 0 ? 0 : DATASET_OFFSET(dataset_byt), BLOCK_BYTES(dataset_byt));
+		retval_byt = Checksum(out_block_byt, BLOCK_BYTES(dataset_byt), 0) == read_checksum(dataset_byt) ? 0 : 2;
+		if (dataset_byt == 0) {
+			for (byte id_byt = VAR_GLOBAL(0); id_byt < VAR_MODEL(0); id_byt++) {
+				if (pgm_read_byte(&AllVars_obj[id_byt].Flags_byt) & VAR_LOGGED)
+					out_block_byt[pgm_read_byte(&AllVars_obj[id_byt].Offset_byt)] = GetVar(0, id_byt); // 'b'-type
 			}
 		}
-		// for each channel
-		for (byte chan_byt = 1; chan_byt <= CHANNELS; chan_byt++) {
-			// for each variable
-			for (byte idx_byt = 0; idx_byt < VARS_PER_CHANNEL; idx_byt++) {
-				getProgmemStrArrayValue(var_str, ChanVarNames_str, idx_byt, MAXVARNAME + 1);
-				format_variable_name(var_str, chan_byt, name_str);
-				out_channels_int[chan_byt - 1][idx_byt] = GetVar(dataset_byt, name_str);
-			}
+	}
+	return retval_byt;
+}
+
+// Write given block, BlockSize() bytes in the layout of the EEProm, and its checksum
+// Nothing is written unless all the values are valid
+// dataset_byt: 0=global variables, or dataset number [1, NDATASETS]
+// return value: 0=ok, 1=invalid dataset, 2=invalid value
+byte ArduinotxEeprom::SetBlock(byte dataset_byt, const byte *block_byt) {
+	byte retval_byt = 1;
+	if (dataset_byt == 0)
+		retval_byt = validate_values(VAR_GLOBAL(0), VAR_MODEL(0), block_byt) ? 0 : 2;
+	else if (dataset_byt <= NDATASETS) {
+		retval_byt = validate_values(VAR_MODEL(0), VAR_MIXER(0), block_byt) ? 0 : 2;
+		for (byte mixer_byt = 0; mixer_byt < NMIXERS && retval_byt == 0; mixer_byt++) {
+			if (!validate_values(VAR_MIXER(0), VAR_CHANNEL(0), block_byt + BYTES_PER_MODEL + mixer_byt * BYTES_PER_MIXER))
+				retval_byt = 2;
+		}
+		for (byte chan_byt = 0; chan_byt < CHANNELS && retval_byt == 0; chan_byt++) {
+			if (!validate_values(VAR_CHANNEL(0), VARS, block_byt + BYTES_PER_MODEL + NMIXERS * BYTES_PER_MIXER + chan_byt * BYTES_PER_CHANNEL))
+				retval_byt = 2;
 		}
 	}
-	else
-		retval_byt = 1; // invalid dataset
+	if (retval_byt == 0) {
+		int offset_int = dataset_byt == 0 ? 0 : DATASET_OFFSET(dataset_byt);
+		for (byte idx_byt = 0; idx_byt < BLOCK_BYTES(dataset_byt); idx_byt++)
+			write_byte(offset_int + idx_byt, block_byt[idx_byt]);
+		store_checksum(dataset_byt, Checksum(block_byt, BLOCK_BYTES(dataset_byt), 0));
+		// the log keeps the current value of the VAR_LOGGED variables
+	}
 	return retval_byt;
 }
 
-// Print the serialized data of given dataset on the Serial port
+// Print a line of the serialized data of given dataset on the Serial port
+// The dump is produced one line per call, so that the caller can wait for room in the Serial transmit buffer between the lines
 // dataset_int: 0=global variables, or dataset number [1, NDATASETS]
 // channel_int: channel_int is ignored if dataset_int==0
-//	0 : model vars, all mixer vars and all channel vars in dataset, 
+//	0 : model vars, all mixer vars and all channel vars in dataset,
 //	[1, CHANNELS] : this channel only
 //	CHANNELS+1 : model vars only
 //	CHANNELS+2 : mixer vars only
-// return value: 0=Ok, 1=error
-byte ArduinotxEeprom::Serialize(byte dataset_byt, byte channel_byt) {
-	int retval_byt = 0;
-	char var_str[MAXVARNAME + 1];
-	if (dataset_byt == 0) {
-		aPrintfln(PSTR("%c Global"), COMMENT_TOKEN);
-		// for each global variable, skipping IDLIB (index 0) and VERLIB (index 1) that are read-only
-		for (byte idx_byt = 2; idx_byt < GLOBAL_VARS; idx_byt++) {
-			getProgmemStrArrayValue(var_str, GlobalVarNames_str, idx_byt, MAXVARNAME + 1);
-			serialize_variable(dataset_byt, var_str, 0);
-		}
-	}
-	else if (dataset_byt > 0 && dataset_byt <= NDATASETS) {
-		if (channel_byt == 0 || channel_byt == CHANNELS+1) {
-			// for each model variable
-			for (byte idx_byt = 0; idx_byt < VARS_PER_MODEL; idx_byt++) {
-				getProgmemStrArrayValue(var_str, ModelVarNames_str, idx_byt, MAXVARNAME + 1);
-				serialize_variable(dataset_byt, var_str, 0);
+// inout_item_int: position in the dump, 0 for the first line, advanced to the next line
+// return value: 0=a line has been printed, 1=end of the dump or invalid dataset
+// A line has at most SERIALIZED_LINE_BYTES characters
+byte ArduinotxEeprom::SerializeLine(byte dataset_byt, byte channel_byt, int *inout_item_int) {
+	while (true) {
+		int item_int = (*inout_item_int)++;
+		if (dataset_byt == 0) {
+			if (item_int == 0) {
+				aPrintfln(PSTR("%c Global"), COMMENT_TOKEN);
+				return 0;
+			}
+			// each global variable, skipping the read-only LIB and VER
+			if (item_int > GLOBAL_VARS)
+				return 1;
+			byte id_byt = VAR_GLOBAL(item_int - 1);
+			if (!(pgm_read_byte(&AllVars_obj[id_byt].Flags_byt) & VAR_READONLY)) {
+				serialize_variable(dataset_byt, id_byt, 0);
+				return 0;
 			}
 		}
-		if (channel_byt == 0 || channel_byt == CHANNELS+2) {
-			aPrintfln(PSTR("%c Mixers"), COMMENT_TOKEN);
-			// for each mixer
-			for (byte mixer_byt = 1; mixer_byt <= NMIXERS; mixer_byt++) {
-				// for each variable
-				for (byte idx_byt = 0; idx_byt < VARS_PER_MIXER; idx_byt++) {
-					getProgmemStrArrayValue(var_str, MixerVarNames_str, idx_byt, MAXVARNAME + 1);
-					serialize_variable(dataset_byt, var_str, mixer_byt);
+		else if (dataset_byt <= NDATASETS) {
+			if (channel_byt == 0 || channel_byt == CHANNELS+1) {
+				// each model variable
+				if (item_int < VARS_PER_MODEL) {
+					serialize_variable(dataset_byt, VAR_MODEL(item_int), 0);
+					return 0;
 				}
+				item_int -= VARS_PER_MODEL;
 			}
-		}
-		// for each channel
-		for (byte chan_byt = 1; chan_byt <= CHANNELS; chan_byt++) {
-			if (channel_byt == 0 || chan_byt == channel_byt) {
-				aPrintfln(PSTR("%c Channel %d"), COMMENT_TOKEN, chan_byt);
-				// for each variable
-				for (byte idx_byt = 0; idx_byt < VARS_PER_CHANNEL; idx_byt++) {
-					getProgmemStrArrayValue(var_str, ChanVarNames_str, idx_byt, MAXVARNAME + 1);
-					serialize_variable(dataset_byt, var_str, chan_byt);
+			if (channel_byt == 0 || channel_byt == CHANNELS+2) {
+				// each variable of each mixer
+				if (item_int == 0) {
+					aPrintfln(PSTR("%c Mixers"), COMMENT_TOKEN);
+					return 0;
+				}
+				if (item_int <= NMIXERS * VARS_PER_MIXER) {
+					item_int--;
+					serialize_variable(dataset_byt, VAR_MIXER(item_int % VARS_PER_MIXER), item_int / VARS_PER_MIXER + 1);
+					return 0;
+				}
+				item_int -= 1 + NMIXERS * VARS_PER_MIXER;
+			}
+			// each variable of each channel
+			for (byte chan_byt = 1; chan_byt <= CHANNELS; chan_byt++) {
+				if (channel_byt == 0 || chan_byt == channel_byt) {
+					if (item_int == 0) {
+						aPrintfln(PSTR("%c Channel %d"), COMMENT_TOKEN, chan_byt);
+						return 0;
+					}
+					if (item_int <= VARS_PER_CHANNEL) {
+						serialize_variable(dataset_byt, VAR_CHANNEL(item_int - 1), chan_byt);
+						return 0;
+					}
+					item_int -= 1 + VARS_PER_CHANNEL;
 				}
 			}
+			return 1;
 		}
+		else
+			return 1; // invalid dataset
 	}
-	else
-		retval_byt = 1; // invalid dataset
-	return retval_byt;
+}
+
+// Print the next variable of given dataset that differs from another dataset or from the default values, one line per call like SerializeLine()
+// dataset_byt: dataset number [1, NDATASETS] whose values are printed
+// reference_byt: dataset number [1, NDATASETS] compared with, or 0 to compare with the values set by InitBlock()
+// inout_item_int: position in the comparison, 0 to start, advanced past the variable printed
+// return value: 0=a line has been printed, 1=no more differences or invalid dataset
+byte ArduinotxEeprom::DiffLine(byte dataset_byt, byte reference_byt, int *inout_item_int) {
+	if (dataset_byt == 0 || dataset_byt > NDATASETS || reference_byt > NDATASETS)
+		return 1;
+	while (*inout_item_int < DATASET_VARS) {
+		int item_int = (*inout_item_int)++;
+		byte id_byt;
+		byte number_byt = 0;
+		if (item_int < VARS_PER_MODEL)
+			id_byt = VAR_MODEL(item_int);
+		else if ((item_int -= VARS_PER_MODEL) < NMIXERS * VARS_PER_MIXER) {
+			id_byt = VAR_MIXER(item_int % VARS_PER_MIXER);
+			number_byt = item_int / VARS_PER_MIXER + 1;
+		}
+		else {
+			item_int -= NMIXERS * VARS_PER_MIXER;
+			id_byt = VAR_CHANNEL(item_int % VARS_PER_CHANNEL);
+			number_byt = item_int / VARS_PER_CHANNEL + 1;
+		}
+		byte differs_bool;
+		if (id_byt == VAR_MODEL(MOD_NAM)) {
+			char value_str[MAXSTRLEN + 1];
+			char reference_str[MAXSTRLEN + 1];
+			GetVar(dataset_byt, id_byt, 0, value_str);
+			if (reference_byt)
+				GetVar(reference_byt, id_byt, 0, reference_str);
+			else
+				default_name(dataset_byt, reference_str);
+			differs_bool = strcmp(value_str, reference_str) != 0;
+		}
+		else
+			differs_bool = GetVar(dataset_byt, id_byt, number_byt) != (reference_byt ? GetVar(reference_byt, id_byt, number_byt) : default_value(id_byt, number_byt));
+		if (differs_bool) {
+			serialize_variable(dataset_byt, id_byt, number_byt);
+			return 0;
+		}
+	}
+	return 1;
+}
+
+// Write the next changed byte of the write queue, called by ISR(EE_READY_vect) when the EEProm is ready
+// The bytes that the EEProm already contains are skipped
+void ArduinotxEeprom::WriteNext() {
+	while (QueueHead_byt != QueueTail_byt) {
+		unsigned int offset_int = QueueOffset_int[QueueHead_byt];
+		byte value_byt = QueueValue_byt[QueueHead_byt];
+		QueueHead_byt = (QueueHead_byt + 1) & (EEPROM_QUEUE - 1);
+		EEAR = offset_int;
+		EECR |= _BV(EERE);
+		if (EEDR != value_byt) {
+			EEDR = value_byt;
+			EECR |= _BV(EEMPE);
+			EECR |= _BV(EEPE); // erase and write, ISR(EE_READY_vect) is called again when done
+			Writes_lng++;
+			return;
+		}
+		Skipped_lng++;
+	}
+	EECR &= ~_BV(EERIE); // queue empty
+}
+
+// Return the number of bytes waiting in the write queue
+byte ArduinotxEeprom::Pending() {
+	return (QueueTail_byt - QueueHead_byt) & (EEPROM_QUEUE - 1);
+}
+
+// Return the number of bytes written since last ResetStats(), call with interrupts disabled
+unsigned long ArduinotxEeprom::Writes() {
+	return Writes_lng;
+}
+
+// Return the number of bytes not written since last ResetStats() because they were unchanged, call with interrupts disabled
+unsigned long ArduinotxEeprom::SkippedWrites() {
+	return Skipped_lng;
+}
+
+// Reset the write statistics, call with interrupts disabled
+void ArduinotxEeprom::ResetStats() {
+	Writes_lng = 0;
+	Skipped_lng = 0;
 }
 
 /*
 ** Private implementation
 */
 
+// Read the value of given byte, including the value waiting in the write queue
+byte ArduinotxEeprom::read_byte(int offset_int) {
+	byte value_byt;
+	read_block(&value_byt, offset_int, 1);
+	return value_byt;
+}
+
+// Read given bytes, including the values waiting in the write queue
+void ArduinotxEeprom::read_block(byte *out_buffer_byt, int offset_int, byte size_byt) {
+	EECR &= ~_BV(EERIE); // hold ISR(EE_READY_vect): eeprom_read_block() uses EEAR too
+	eeprom_read_block(out_buffer_byt, (const void *)(size_t)offset_int, size_byt);
+	for (byte idx_byt = QueueHead_byt; idx_byt != QueueTail_byt; idx_byt = (idx_byt + 1) & (EEPROM_QUEUE - 1)) {
+		unsigned int pos_int = QueueOffset_int[idx_byt] - offset_int;
+		if (pos_int < size_byt)
+			out_buffer_byt[pos_int] = QueueValue_byt[idx_byt];
+	}
+	if (QueueHead_byt != QueueTail_byt)
+		EECR |= _BV(EERIE);
+}
+
+// Queue given byte for ISR(EE_READY_vect), unless the EEProm or the queue already contains this value
+// Waits if the queue is full: only InitEEProm() writes more than EEPROM_QUEUE bytes at once
+void ArduinotxEeprom::write_byte(int offset_int, byte value_byt) {
+	byte queued_bool = false;
+	EECR &= ~_BV(EERIE); // hold ISR(EE_READY_vect) while the queue is scanned
+	if (eeprom_read_byte((const uint8_t *)(size_t)offset_int) == value_byt)
+		queued_bool = true;
+	for (byte idx_byt = QueueHead_byt; idx_byt != QueueTail_byt; idx_byt = (idx_byt + 1) & (EEPROM_QUEUE - 1)) {
+		if (QueueOffset_int[idx_byt] == (unsigned int)offset_int) {
+			QueueValue_byt[idx_byt] = value_byt; // replace the value waiting in the queue
+			queued_bool = true;
+		}
+	}
+	if (queued_bool)
+		Skipped_lng++;
+	else {
+		byte tail_byt = (QueueTail_byt + 1) & (EEPROM_QUEUE - 1);
+		while (tail_byt == QueueHead_byt) {
+			EECR |= _BV(EERIE);
+			halWait(); // queue full
+		}
+		QueueOffset_int[QueueTail_byt] = offset_int;
+		QueueValue_byt[QueueTail_byt] = value_byt;
+		QueueTail_byt = tail_byt;
+	}
+	if (QueueHead_byt != QueueTail_byt)
+		EECR |= _BV(EERIE);
+}
+
 // convert given short (signed) value originally stored as a byte (unsigned), into a signed integer
 // Arduino does not implement the "short" type. If we store a short value into a byte, we must use conversion functions to preserve the sign
 // negative values[-128,-1] maped to [0,127]; 0 maped to 128; positive values [1,127] maped to [129, 255]
@@ -568,148 +894,258 @@ byte ArduinotxEeprom::int_to_short(int value_int) {
 	return constrain(value_int, -128, 127) + 128;
 }
 
-// Append given number (>= 1) to given variable name (name length must be exactly MAXVARNAME) 
-// Return value: the variable name with the digit appended, length = MAXVARNAME + 1
-void ArduinotxEeprom::format_variable_name(const char *var_str, byte number_byt, char *out_name_str) {
-	strncpy(out_name_str, var_str, MAXVARNAME + 2);
-	if (number_byt) {
-		out_name_str[MAXVARNAME] = '0' + number_byt;
-		out_name_str[MAXVARNAME + 1] = '\0';
+// Return the numerical value of a 'b', 's', 'i'-type variable stored in given bytes, or -1 for an 'a'-type variable
+int ArduinotxEeprom::decode_value(const byte *value_byt, const VarDescriptor *descriptor_ptr) {
+	int retval_int = -1;
+	switch (descriptor_ptr->Type_chr) {
+		case 'b':
+			retval_int = value_byt[0];
+			break;
+
+		case 's':
+			retval_int = short_to_int(value_byt[0]);
+			break;
+
+		case 'i': {
+			union bytes_int {
+				byte value_byt[2];
+				int16_t value_int; // 2 bytes, also when int is larger (host build)
+			} buffer_uni;
+			buffer_uni.value_byt[0] = value_byt[0];
+			buffer_uni.value_byt[1] = value_byt[1];
+			retval_int = buffer_uni.value_int;
+			break;
+		}
+	}
+	return retval_int;
+}
+
+// Test the values of the descriptors [first_byt, last_byt[ stored in given bytes, in the layout of the EEProm
+// Read-only variables must have their default value, 'a'-type values must be printable
+// return value: true if all the values are valid
+byte ArduinotxEeprom::validate_values(byte first_byt, byte last_byt, const byte *values_byt) {
+	byte retval_bool = true;
+	VarDescriptor var_obj;
+	for (byte id_byt = first_byt; id_byt < last_byt && retval_bool; id_byt++) {
+		get_descriptor(id_byt, &var_obj);
+		if (var_obj.Type_chr == 'a') {
+			for (byte idx_byt = 0; idx_byt < var_obj.Size_byt; idx_byt++) {
+				if (values_byt[var_obj.Offset_byt + idx_byt] < ' ' || values_byt[var_obj.Offset_byt + idx_byt] > '~')
+					retval_bool = false;
+			}
+		}
+		else {
+			int value_int = decode_value(values_byt + var_obj.Offset_byt, &var_obj);
+			if (var_obj.Flags_byt & VAR_READONLY)
+				retval_bool = (value_int == var_obj.Default_int); // LIB and VER
+			else
+				retval_bool = (Validate(id_byt, value_int) == 0);
+		}
 	}
+	return retval_bool;
+}
+
+// Copy the descriptor of given variable from PROGMEM
+void ArduinotxEeprom::get_descriptor(byte id_byt, VarDescriptor *out_descriptor) {
+	memcpy_P(out_descriptor, &AllVars_obj[id_byt], sizeof(VarDescriptor));
+}
+
+// Return the value set by InitBlock() in given 'b', 's' or 'i'-type variable
+// number_byt: mixer or channel number, 0 for global and model variables
+int ArduinotxEeprom::default_value(byte id_byt, byte number_byt) {
+	VarDescriptor var_obj;
+	get_descriptor(id_byt, &var_obj);
+	return (var_obj.Flags_byt & VAR_DEFAULT_NUMBER) ? number_byt : var_obj.Default_int;
+}
+
+// Copy the model name set by InitBlock() into given buffer, MAXSTRLEN + 1 bytes
+void ArduinotxEeprom::default_name(byte dataset_byt, char *out_name_str) {
+	aSprintf(out_name_str, MAXSTRLEN + 1, PSTR("MODEL%d"), dataset_byt);
 }
 
 // Print the serialized data of given variable on the Serial port
-void ArduinotxEeprom::serialize_variable(byte dataset_byt, const char *var_str, byte number_byt) {
+void ArduinotxEeprom::serialize_variable(byte dataset_byt, byte id_byt, byte number_byt) {
 	char name_str[MAXVARNAME + 2]; // 2 = 1 channel digit + 1 \0
-	format_variable_name(var_str, number_byt, name_str);
-	char type_chr = GetType(dataset_byt, name_str);
-	if (type_chr == 'a') {
+	GetName(id_byt, number_byt, name_str);
+	if (GetType(id_byt) == 'a') {
 		char value_str[MAXSTRLEN + 1]; // 9, at least 7 to fit string representation of int's: 7 = 6 int value + 1 \0
-		GetVar(dataset_byt, name_str, value_str);
+		GetVar(dataset_byt, id_byt, number_byt, value_str);
 		aPrintfln(PSTR("%s=%s"), name_str, value_str);
 	}
 	else
-		aPrintfln(PSTR("%s=%d"), name_str, GetVar(dataset_byt, name_str));
+		aPrintfln(PSTR("%s=%d"), name_str, GetVar(dataset_byt, id_byt, number_byt));
 }
 
-// Return the offset in the EEProm and the size and type of given variable, or -1 on invalid name or invalid dataset
-// dataset_byt : 0=global var, [1, 9]=model var, channel var or a mixer var
+// Return the offset in the EEProm of given variable and copy its descriptor, or -1 on invalid variable or invalid dataset
+// dataset_byt : 0=global var, [1, NDATASETS]=model var, channel var or a mixer var
+// number_byt: mixer number [1, NMIXERS] or channel number [1, CHANNELS], 0 for global and model variables
 // see "EEPROM layout" comments at the top of this file
-int ArduinotxEeprom::get_var_offset(byte dataset_byt, const char *var_str, byte *out_size_byt, char *out_type_chr) {
+int ArduinotxEeprom::get_var_offset(byte dataset_byt, byte id_byt, byte number_byt, VarDescriptor *out_descriptor) {
 	int retval_int = -1;
-	int varlen_int = strlen(var_str);
-	int idx_int = 0;
-	int ix_int = 0;
-	
-	if (dataset_byt == 0) {
-		// global variable
-		if (varlen_int > 0 && varlen_int <= MAXVARNAME) {
-			// seek index of var in GlobalVarNames_str[]
-			idx_int = findProgmemStrArrayIndex(GlobalVarNames_str, var_str);
-			if (idx_int >= 0) {
-				// compute the corresponding offset in the EEProm
-				retval_int = 0;
-				ix_int = 0;
-				while (ix_int < idx_int) { // size of previous variables in current channel
-					retval_int += getProgmemByteArrayValue(GlobalVarSize_byt, ix_int);
-					ix_int++;
+	if (id_byt < VARS) {
+		get_descriptor(id_byt, out_descriptor);
+		if (id_byt < VAR_MODEL(0)) {
+			// global variable
+			if (dataset_byt == 0) {
+				retval_int = out_descriptor->Offset_byt;
+				if (out_descriptor->Flags_byt & VAR_LOGGED) {
+					int log_int = log_offset(id_byt);
+					if (log_int >= 0)
+						retval_int = log_int;
 				}
-				// return the value size
-				*out_size_byt = getProgmemByteArrayValue(GlobalVarSize_byt, idx_int);
-				// return the type
-				*out_type_chr = getProgmemByteArrayValue(GlobalVarType_byt, idx_int);
 			}
 		}
-	}
-	else if (dataset_byt > 0 && dataset_byt <= NDATASETS) {
-		// model, mixer or channel variable
-		if (varlen_int > 0 && varlen_int <= MAXVARNAME + 1) {
-			char name_str[MAXVARNAME + 2];
-			strcpy(name_str, var_str);
-
-			// if last char is a digit then var_str is a channel var or a mixer var
-			// 	and this digit is a channel number or a mixer number
-			// else var_str is a model var
-			char last_char = var_str[varlen_int - 1];
-			if (last_char >= '0' && last_char <= '9') {
-				byte number_byt = last_char - '0';
-			
-				// overwrite the last character of the var name:
-				// for a channel variable this will remove the channel number and keep the base name: eg "ICT1" -> "ICT"
-				// for a mixer variable this will remove the mixer number and keep the base name: eg "N1M1" -> "N1M"
-				name_str[varlen_int - 1] = '\0'; 
-							
-				// look for mixer variable
-				idx_int = -1;
-				if (number_byt >0 && number_byt <= NMIXERS) {
-					// seek index of var in MixerVarNames_str[]
-					idx_int = findProgmemStrArrayIndex(MixerVarNames_str, name_str);
-					if (idx_int >= 0) {
-						// compute the corresponding offset in the EEProm
-						retval_int = GLOBAL_BYTES;
-						retval_int += (dataset_byt - 1) * BYTES_PER_DATASET; // size of previous datasets
-						retval_int += BYTES_PER_MODEL; // size of model variables in current dataset
-						retval_int += (number_byt - 1) * BYTES_PER_MIXER; // size of previous mixers in current dataset
-						ix_int = 0;
-						while (ix_int < idx_int) {	// size of previous variables in current mixer
-							retval_int += getProgmemByteArrayValue(MixerVarSize_byt, ix_int);
-							ix_int++;
-						}
-						// return the value size
-						*out_size_byt = getProgmemByteArrayValue(MixerVarSize_byt, idx_int);
-						// return the type
-						*out_type_chr = getProgmemByteArrayValue(MixerVarType_byt, idx_int);
-					}
-				}
-				
-				if (idx_int == -1) {
-					// not found in mixers, look for channel variable
-					if (number_byt >0 && number_byt <= CHANNELS) {
-						// seek index of var in ChanVarNames_str[]
-						idx_int = findProgmemStrArrayIndex(ChanVarNames_str, name_str);
-						if (idx_int >= 0) {
-							// compute the corresponding offset in the EEProm
-							retval_int = GLOBAL_BYTES;
-							retval_int += (dataset_byt - 1) * BYTES_PER_DATASET; // size of previous datasets
-							retval_int += BYTES_PER_MODEL; // size of model variables in current dataset
-							retval_int += NMIXERS * BYTES_PER_MIXER; // size of the mixers of current dataset
-							retval_int += (number_byt - 1) * BYTES_PER_CHANNEL; // size of previous channels in current dataset
-							ix_int = 0;
-							while (ix_int < idx_int) {	// size of previous variables in current channel
-								retval_int += getProgmemByteArrayValue(ChanVarSize_byt, ix_int);
-								ix_int++;
-							}
-							// return the value size
-							*out_size_byt = getProgmemByteArrayValue(ChanVarSize_byt, idx_int);
-							// return the type
-							*out_type_chr = getProgmemByteArrayValue(ChanVarType_byt, idx_int);
-						}
-					}
-				}
+		else if (dataset_byt > 0 && dataset_byt <= NDATASETS) {
+			int dataset_int = DATASET_OFFSET(dataset_byt);
+			if (id_byt < VAR_MIXER(0))
+				retval_int = dataset_int + out_descriptor->Offset_byt; // model variable
+			else if (id_byt < VAR_CHANNEL(0)) {
+				// mixer variable
+				if (number_byt > 0 && number_byt <= NMIXERS)
+					retval_int = dataset_int + BYTES_PER_MODEL + (number_byt - 1) * BYTES_PER_MIXER + out_descriptor->Offset_byt;
 			}
 			else {
-				// look for model variable
-				// seek index of var in ModelVarNames_str[]
-				idx_int = findProgmemStrArrayIndex(ModelVarNames_str, name_str);
-				if (idx_int >= 0) {
-					// compute the corresponding offset in the EEProm
-					retval_int = GLOBAL_BYTES;
-					retval_int += (dataset_byt - 1) * BYTES_PER_DATASET; // size of previous datasets
-					ix_int = 0;
-					while (ix_int < idx_int) {	// size of previous variables in current model
-						retval_int += getProgmemByteArrayValue(ModelVarSize_byt, ix_int);
-						ix_int++;
-					}
-					// return the value size
-					*out_size_byt = getProgmemByteArrayValue(ModelVarSize_byt, idx_int);
-					// return the type
-					*out_type_chr = getProgmemByteArrayValue(ModelVarType_byt, idx_int);
-				}
+				// channel variable
+				if (number_byt > 0 && number_byt <= CHANNELS)
+					retval_int = dataset_int + BYTES_PER_MODEL + NMIXERS * BYTES_PER_MIXER + (number_byt - 1) * BYTES_PER_CHANNEL + out_descriptor->Offset_byt;
 			}
 		}
 	}
 	return retval_int;
 }
 
+// Add given bytes to a Fletcher-16 checksum, sums_int: checksum of the previous bytes of the block, 0 for the first ones
+// Also used to check the frames of the binary transfers, see ArduinotxCmd
+unsigned int ArduinotxEeprom::Checksum(const byte *buffer_byt, byte size_byt, unsigned int sums_int) {
+	unsigned int sum1_int = sums_int & 0xFF;
+	unsigned int sum2_int = sums_int >> 8;
+	for (byte idx_byt = 0; idx_byt < size_byt; idx_byt++) {
+		sum1_int = (sum1_int + buffer_byt[idx_byt]) % 255;
+		sum2_int = (sum2_int + sum1_int) % 255;
+	}
+	return (sum2_int << 8) | sum1_int;
+}
 
+// Compute the checksum of the bytes of given block
+unsigned int ArduinotxEeprom::block_checksum(byte dataset_byt) {
+	byte buffer_byt[16];
+	unsigned int sums_int = 0;
+	int offset_int = dataset_byt == 0 ? 0 : DATASET_OFFSET(dataset_byt);
+	int end_int = offset_int + BLOCK_BYTES(dataset_byt);
+	while (offset_int < end_int) {
+		byte size_byt = min(end_int - offset_int, (int)sizeof(buffer_byt));
+		read_block(buffer_byt, offset_int, size_byt);
+		sums_int = Checksum(buffer_byt, size_byt, sums_int);
+		offset_int += size_byt;
+	}
+	return sums_int;
+}
+
+// Return the checksum stored for given block
+unsigned int ArduinotxEeprom::read_checksum(byte dataset_byt) {
+	byte checksum_byt[2];
+	read_block(checksum_byt, CHECK_OFFSET + 2 * dataset_byt, 2);
+	return checksum_byt[0] | (checksum_byt[1] << 8);
+}
+
+void ArduinotxEeprom::store_checksum(byte dataset_byt, unsigned int checksum_int) {
+	write_byte(CHECK_OFFSET + 2 * dataset_byt, checksum_int & 0xFF);
+	write_byte(CHECK_OFFSET + 2 * dataset_byt + 1, checksum_int >> 8);
+}
 
+// Write given byte of a block and update the checksum of the block
+// The weight of the byte in the second sum is the number of bytes from its position to the end of the block
+void ArduinotxEeprom::update_byte(int offset_int, byte value_byt) {
+	byte old_byt = read_byte(offset_int);
+	if (old_byt != value_byt) {
+		byte dataset_byt = 0;
+		int pos_int = offset_int;
+		if (offset_int >= GLOBAL_BYTES) {
+			dataset_byt = (offset_int - GLOBAL_BYTES) / BYTES_PER_DATASET + 1;
+			pos_int = offset_int - DATASET_OFFSET(dataset_byt);
+		}
+		unsigned int sums_int = read_checksum(dataset_byt);
+		unsigned int delta_int = (value_byt % 255 + 255 - old_byt % 255) % 255;
+		unsigned int sum1_int = ((sums_int & 0xFF) + delta_int) % 255;
+		unsigned int sum2_int = ((sums_int >> 8) + (BLOCK_BYTES(dataset_byt) - pos_int) * delta_int) % 255;
+		write_byte(offset_int, value_byt);
+		store_checksum(dataset_byt, (sum2_int << 8) | sum1_int);
+	}
+}
+
+// Find the next entry to write in the log and the latest entry of each VAR_LOGGED variable, called once at the first access
+// log_offset_int: log_offset_int, or the offset of the log in an older layout, see CheckEEProm()
+void ArduinotxEeprom::find_log(int log_offset_int) {
+	byte entries_byt = (E2END + 1 - log_offset_int) / LOG_ENTRY_BYTES;
+	byte first_lap_byt = read_byte(log_offset_int + 1) & LOG_LAP;
+	LogNext_byt = 0;
+	LogLap_byt = first_lap_byt ^ LOG_LAP; // all the entries belong to the same pass, start a new pass
+	for (byte entry_byt = 1; entry_byt < entries_byt; entry_byt++) {
+		if ((read_byte(log_offset_int + entry_byt * LOG_ENTRY_BYTES + 1) & LOG_LAP) != first_lap_byt) {
+			LogNext_byt = entry_byt; // the current pass stopped here
+			LogLap_byt = first_lap_byt;
+			break;
+		}
+	}
+	for (byte slot_byt = 0; slot_byt < LOG_VARS; slot_byt++)
+		LogLatest_byt[slot_byt] = LOG_NONE;
+	// scan back from the latest entry, the values out of range are ignored
+	byte entry_byt = LogNext_byt;
+	for (byte count_byt = 0; count_byt < entries_byt; count_byt++) {
+		entry_byt = (entry_byt == 0 ? entries_byt : entry_byt) - 1;
+		byte id_byt = read_byte(log_offset_int + entry_byt * LOG_ENTRY_BYTES + 1) & (byte)~LOG_LAP;
+		if (id_byt < VAR_MODEL(0) && (pgm_read_byte(&AllVars_obj[id_byt].Flags_byt) & VAR_LOGGED)) {
+			byte slot_byt = log_slot(id_byt);
+			int value_int = read_byte(log_offset_int + entry_byt * LOG_ENTRY_BYTES);
+			if (LogLatest_byt[slot_byt] == LOG_NONE && value_int >= (int)pgm_read_word(&AllVars_obj[id_byt].Min_int) && value_int <= (int)pgm_read_word(&AllVars_obj[id_byt].Max_int))
+				LogLatest_byt[slot_byt] = entry_byt;
+		}
+	}
+	LogFound_bool = true;
+}
+
+// Return the index of given VAR_LOGGED variable in LogLatest_byt[]
+byte ArduinotxEeprom::log_slot(byte id_byt) {
+	byte retval_byt = 0;
+	for (byte idx_byt = 0; idx_byt < id_byt; idx_byt++) {
+		if (pgm_read_byte(&AllVars_obj[idx_byt].Flags_byt) & VAR_LOGGED)
+			retval_byt++;
+	}
+	return retval_byt;
+}
+
+// Return the offset in the EEProm of the latest value of given VAR_LOGGED variable, or -1 if the log contains no value of this variable
+int ArduinotxEeprom::log_offset(byte id_byt) {
+	int retval_int = -1;
+	if (!LogFound_bool)
+		find_log(LOG_OFFSET);
+	byte entry_byt = LogLatest_byt[log_slot(id_byt)];
+	if (entry_byt != LOG_NONE)
+		retval_int = LOG_OFFSET + entry_byt * LOG_ENTRY_BYTES;
+	return retval_int;
+}
+
+// Append a new value of given VAR_LOGGED variable to the log, unless it is the current value
+// The value is queued before the header, the entry is valid once its header has been written
+// Return value: 0=ok, 1=value out of the range of the variable, nothing written
+byte ArduinotxEeprom::log_write(byte id_byt, int value_int) {
+	byte retval_byt = 1;
+	VarDescriptor var_obj;
+	get_descriptor(id_byt, &var_obj);
+	if (value_int >= var_obj.Min_int && value_int <= var_obj.Max_int) {
+		byte value_byt = value_int; // 'b'-type
+		int offset_int = log_offset(id_byt);
+		if (offset_int < 0 || read_byte(offset_int) != value_byt) {
+			offset_int = LOG_OFFSET + LogNext_byt * LOG_ENTRY_BYTES;
+			write_byte(offset_int, value_byt);
+			write_byte(offset_int + 1, LogLap_byt | id_byt);
+			LogLatest_byt[log_slot(id_byt)] = LogNext_byt;
+			if (++LogNext_byt == LOG_ENTRIES) {
+				LogNext_byt = 0;
+				LogLap_byt ^= LOG_LAP;
+			}
+		}
+		retval_byt = 0;
+	}
+	return retval_byt;
+}
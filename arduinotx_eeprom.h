@@ -27,12 +27,24 @@ Contact information: http://www.reseau.org/arduinorc/index.php?n=Main.Contact
 * 
 ** 09-10-2015 revised PROGMEM vaiabledefs to latest avr-Compiler (>= 1.6) requirements
 ** 01-11-2016 merged latest version of arduinotx (1.5.5) into arduinodtx
+** 16-10-2026 GLOBAL_SBR
+** 16-10-2026 variable descriptors VarDescriptor, variables accessed by descriptor index instead of name
+** 16-10-2026 decode_value()
+** 16-10-2026 write queue drained by ISR(EE_READY_vect), EEPROM_QUEUE
+** 16-10-2026 VAR_LOGGED variables written in a wear-leveled log, LOG_VARS
+** 16-10-2026 checksum of each block: CheckBlock(), InitBlock()
+** 16-10-2026 GlobalSettings and DatasetSettings, loaded with the EEProm layout by GetGlobal() and GetDataset()
+** 16-10-2026 BlockSize(), GetBlock(), SetBlock(), Checksum() public
+** 16-10-2026 SerializeLine() replaces Serialize(), SERIALIZED_LINE_BYTES
+** 16-10-2026 DiffLine()
+** 16-10-2026 log_write() returns an error on a value out of range
 */
 
 #ifndef arduinotx_eeprom_h
 #define arduinotx_eeprom_h
 #include <Arduino.h>
 #include <EEPROM.h>
+#include "arduinotx_config.h" // CHANNELS, also when this file is included first
 
 // number of data sets (models) stored in EEProm
 #if CHANNELS == 9
@@ -50,26 +62,36 @@ Contact information: http://www.reseau.org/arduinorc/index.php?n=Main.Contact
 // at least 6 to fit string representation of int's in serialize_variable()
 #define MAXSTRLEN 8
 
-// number of global variables (number of items in GlobalVarNames_str[])
-#define GLOBAL_VARS 22
+// longest line printed by SerializeLine(), "NAME=value\r\n" with a variable number
+#define SERIALIZED_LINE_BYTES (MAXVARNAME + 1 + 1 + MAXSTRLEN + 2)
 
-// number of variables of each model (number of items in ModelVarNames_str[])
+// number of global variables
+#define GLOBAL_VARS 23
+
+// number of variables of each model
 #define VARS_PER_MODEL 2
 
 // number of mixers defined in each dataset
 // if you need more mixers you can simply change this value
 #define NMIXERS 2
 
-// number of variables of each mixer (number of items in MixerVarNames_str[])
+// number of variables of each mixer
 #define VARS_PER_MIXER 4
 
-// number of variables of each channel (number of items in ChanVarNames_str[])
+// number of variables of each channel
 #define VARS_PER_CHANNEL 10
 
+// number of bytes waiting to be written by ISR(EE_READY_vect), power of 2
+// writing a byte takes 3.4 ms: a full queue is written in about 54 ms
+#define EEPROM_QUEUE 16
+
+// number of global variables written in the log after the last dataset (VAR_LOGGED descriptors)
+#define LOG_VARS 1
+
 // comments start by '#'
 #define COMMENT_TOKEN '#'
 
-// symbolic names defined for the global variables and their index in array GlobalVarNames_str[]
+// symbolic names defined for the global variables and their index in the global variables
 #define GLOBAL_LIB 0
 #define GLOBAL_VER 1
 #define GLOBAL_CDS 2
@@ -78,18 +100,19 @@ Contact information: http://www.reseau.org/arduinorc/index.php?n=Main.Contact
 #define GLOBAL_BAT 5
 #define GLOBAL_KL1 6
 #define GLOBAL_KH1 14
+#define GLOBAL_SBR 22
 
-// symbolic names defined for the model variables and their index in array ModelVarNames_str[]
+// symbolic names defined for the model variables and their index in the model variables
 #define MOD_NAM 0
 #define MOD_THC 1
 
-// symbolic names defined for the mixer variables and their index in array MixerVarNames_str[]
+// symbolic names defined for the mixer variables and their index in the mixer variables
 #define MIX_N1M 0
 #define MIX_P1M 1
 #define MIX_N2M 2
 #define MIX_P2M 3
 
-// symbolic names defined for the channel variables and their index in array ChanVarNames_str[]
+// symbolic names defined for the channel variables and their index in the channel variables
 #define CHAN_ICT 0
 #define CHAN_ICN 1
 #define CHAN_REV 2
@@ -111,61 +134,158 @@ Contact information: http://www.reseau.org/arduinorc/index.php?n=Main.Contact
 #define CAL_LOW 0
 #define CAL_HIGH 1
 
-// Make Global variables names visible to other modules
-extern const char Gvn_LIB[] PROGMEM, Gvn_VER[] PROGMEM, Gvn_CDS[] PROGMEM, Gvn_ADS[] PROGMEM, Gvn_TSC[] PROGMEM, Gvn_BAT[] PROGMEM, 
-	Gvn_KL1[] PROGMEM, Gvn_KL2[] PROGMEM, Gvn_KL3[] PROGMEM, Gvn_KL4[] PROGMEM, Gvn_KL5[] PROGMEM, Gvn_KL6[] PROGMEM, Gvn_KL7[] PROGMEM, Gvn_KL8[] PROGMEM, 
-	Gvn_KH1[] PROGMEM, Gvn_KH2[] PROGMEM, Gvn_KH3[] PROGMEM, Gvn_KH4[] PROGMEM, Gvn_KH5[] PROGMEM, Gvn_KH6[] PROGMEM, Gvn_KH7[] PROGMEM, Gvn_KH8[] PROGMEM;
+// Variable descriptors ----------------------------------------------------------
+// All variables are described by a single table in arduinotx_eeprom.cpp, in this order: global, model, mixer and channel variables.
+// A variable is identified by the index of its descriptor in this table, and by a mixer or channel number for mixer and channel variables.
+// Variable names are only used by the command interpreter, see FindVar()
 
-// Make Model variables names visible to other modules
-extern const char 	Gvn_NAM[] PROGMEM, Gvn_THC[] PROGMEM;
+// index of the descriptor of given variable; idx: GLOBAL_*, MOD_*, MIX_*, CHAN_*
+#define VAR_GLOBAL(idx) (idx)
+#define VAR_MODEL(idx) (GLOBAL_VARS + (idx))
+#define VAR_MIXER(idx) (GLOBAL_VARS + VARS_PER_MODEL + (idx))
+#define VAR_CHANNEL(idx) (GLOBAL_VARS + VARS_PER_MODEL + VARS_PER_MIXER + (idx))
 
-// Make Mixer variables names visible to other modules
-extern const char 	Gvn_N1M[] PROGMEM, Gvn_P1M[] PROGMEM, Gvn_N2M[] PROGMEM, Gvn_P2M[] PROGMEM;
+// number of descriptors
+#define VARS (GLOBAL_VARS + VARS_PER_MODEL + VARS_PER_MIXER + VARS_PER_CHANNEL)
 
-// Make Channel variables names visible to other modules
-extern const char Gvn_ICT[] PROGMEM,	Gvn_ICN[] PROGMEM, Gvn_REV[] PROGMEM, Gvn_DUA[] PROGMEM, Gvn_EXP[] PROGMEM,
-	Gvn_PWL[] PROGMEM, Gvn_PWH[] PROGMEM, Gvn_EPL[] PROGMEM, Gvn_EPH[] PROGMEM, Gvn_SUB[] PROGMEM,
-	Gvn_N1M[] PROGMEM, Gvn_P1M[] PROGMEM, Gvn_N2M[] PROGMEM, Gvn_P2M[] PROGMEM;
-	
+// flags of the variable descriptors
+#define VAR_READONLY 1			// cannot be set by a command, not serialized
+#define VAR_BAUDRATE 2			// the value must also be one of ArduinotxSsc::Baudrates_int[]
+#define VAR_DEFAULT_NUMBER 4	// the default value is the channel number
+#define VAR_PULSE_WIDTH 8		// the range is [ArduinoTx::PPM_LOW, 10 * ArduinoTx::PPM_LOW] instead of [Min_int, Max_int]
+#define VAR_LOGGED 16			// frequently written 'b'-type global variable: each value is appended to the wear-leveled log
+
+typedef struct VarDescriptors {
+	char Name_str[MAXVARNAME + 1];	// the mixer or channel number is appended to this name for mixer and channel variables
+	char Type_chr;		// a)rray of chars, b)yte, i)nt, s)hort : a short is a signed byte
+	byte Size_byt;		// size of the value in EEPROM
+	byte Offset_byt;	// offset of the value in its group: global variables, model, mixer or channel
+	byte Flags_byt;		// VAR_*
+	int Min_int;		// range of the numerical values accepted by the commands
+	int Max_int;
+	int Default_int;	// value set by InitEEProm(), fill character for 'a'-type variables
+} VarDescriptor;
+
+// Variable found by FindVar()
+typedef struct VarRefs {
+	byte Id_byt;		// index of its descriptor
+	byte Number_byt;	// mixer or channel number, 0 for global and model variables
+} VarRef;
+
+// Values of the variables loaded in RAM --------------------------------------------
+// The fields have the size and offset of the values in the EEProm, so that GetGlobal() and GetDataset() load each block in a single read.
+// They are checked against the descriptors in arduinotx_eeprom.cpp.
+// 'i'-type values are int16_t, 's'-type values are converted to int8_t by GetDataset(). The structs are packed for the host build, avr-gcc never pads.
+
+// Global variables, see GetGlobal()
+typedef struct GlobalSettingss {
+	byte Lib_byt;
+	byte Ver_byt;
+	byte Cds_byt;		// latest value in the log, see VAR_LOGGED
+	byte Ads_byt;
+	int16_t Tsc_int;
+	int16_t Bat_int;
+	int16_t Cal_int[2][8];	// [CAL_LOW or CAL_HIGH][potentiometer number - 1]: KL1-KL8, KH1-KH8
+	int16_t Sbr_int;
+} __attribute__((packed)) GlobalSettings;
+
+typedef struct ModelSettingss {
+	char Nam_chr[MAXSTRLEN];	// padded with spaces, not terminated
+	byte Thc_byt;
+} __attribute__((packed)) ModelSettings;
+
+typedef struct MixerSettingss {
+	byte N1m_byt;
+	int8_t P1m_chr;
+	byte N2m_byt;
+	int8_t P2m_chr;
+} __attribute__((packed)) MixerSettings;
+
+typedef struct ChannelSettingss {
+	byte Ict_byt;
+	byte Icn_byt;
+	byte Rev_byt;
+	byte Dua_byt;
+	byte Exp_byt;
+	int16_t Pwl_int;
+	int16_t Pwh_int;
+	byte Epl_byt;
+	byte Eph_byt;
+	int8_t Sub_chr;
+} __attribute__((packed)) ChannelSettings;
+
+// Variables of a dataset, see GetDataset()
+typedef struct DatasetSettingss {
+	ModelSettings Model_obj;
+	MixerSettings Mixers_obj[NMIXERS];
+	ChannelSettings Channels_obj[CHANNELS];
+} __attribute__((packed)) DatasetSettings;
 
 class ArduinotxEeprom {
 	private:
-		static PGM_P const GlobalVarNames_str[] PROGMEM;
-		static const byte GlobalVarSize_byt[] PROGMEM;
-		static const byte GlobalVarType_byt[] PROGMEM;
-		static const int GlobalVarDefault_int[] PROGMEM;
-		
-		static PGM_P const ModelVarNames_str[] PROGMEM;
-		static const byte ModelVarSize_byt[] PROGMEM;
-		static const byte ModelVarType_byt[] PROGMEM;
-		static const int ModelVarDefault_int[] PROGMEM;
-	
-		static PGM_P const MixerVarNames_str[] PROGMEM;
-		static const byte MixerVarSize_byt[] PROGMEM;
-		static const byte MixerVarType_byt[] PROGMEM;
-		static const int MixerVarDefault_int[] PROGMEM;
-		
-		static PGM_P const ChanVarNames_str[] PROGMEM;
-		static const byte ChanVarSize_byt[] PROGMEM;
-		static const byte ChanVarType_byt[] PROGMEM;
-		static const int ChanVarDefault_int[] PROGMEM;
-	
-		int get_var_offset(byte dataset_byt, const char *var_str, byte *out_size_int, char *out_type_chr);
-		void format_variable_name(const char *var_str, byte channel_byt, char *out_name_str);
-		void serialize_variable(byte dataset_byt, const char *var_str, byte channel_byt);
+		// write queue, from QueueHead_byt (next byte written by ISR(EE_READY_vect)) to QueueTail_byt (next free entry)
+		volatile unsigned int QueueOffset_int[EEPROM_QUEUE];
+		volatile byte QueueValue_byt[EEPROM_QUEUE];
+		volatile byte QueueHead_byt;
+		volatile byte QueueTail_byt;
+		volatile unsigned long Writes_lng;	// bytes written since last ResetStats()
+		volatile unsigned long Skipped_lng;	// bytes not written since last ResetStats() because the EEProm already contained the value
+
+		byte read_byte(int offset_int);
+		void read_block(byte *out_buffer_byt, int offset_int, byte size_byt);
+		void write_byte(int offset_int, byte value_byt);
+
+		// wear-leveled log
+		byte LogFound_bool;				// false until find_log() has scanned the log
+		byte LogNext_byt;				// entry written by the next log_write()
+		byte LogLap_byt;				// lap bit of the entries written in the current pass over the log
+		byte LogLatest_byt[LOG_VARS];	// latest entry of each VAR_LOGGED variable
+
+		// checksums
+		unsigned int block_checksum(byte dataset_byt);
+		unsigned int read_checksum(byte dataset_byt);
+		void store_checksum(byte dataset_byt, unsigned int checksum_int);
+		void update_byte(int offset_int, byte value_byt);
+		byte validate_values(byte first_byt, byte last_byt, const byte *values_byt);
+
+		void find_log(int log_offset_int);
+		byte log_slot(byte id_byt);
+		int log_offset(byte id_byt);
+		byte log_write(byte id_byt, int value_int);
+		void get_descriptor(byte id_byt, VarDescriptor *out_descriptor);
+		int get_var_offset(byte dataset_byt, byte id_byt, byte number_byt, VarDescriptor *out_descriptor);
+		void serialize_variable(byte dataset_byt, byte id_byt, byte number_byt);
+		int default_value(byte id_byt, byte number_byt);
+		void default_name(byte dataset_byt, char *out_name_str);
+		int decode_value(const byte *value_byt, const VarDescriptor *descriptor_ptr);
 		int short_to_int(int value_byt);
 		byte int_to_short(int value_int);
 	
 	public:
 		void InitEEProm();
+		void InitBlock(byte dataset_byt);
 		int CheckEEProm();
-		byte IsVar(byte dataset_int, const char *var_str);
-		char GetType(byte dataset_byt, const char *var_str);
-		int GetVar(byte dataset_byt, const char *var_str);
-		int GetVar(byte dataset_byt, const char *var_str, char *out_value_str);
-		byte SetVar(byte dataset_byt,char const *var_str, int value_int, const char *value_str = NULL);
-		void GetGlobal(int out_global_int[]);
-		byte GetDataset(byte dataset_byt, int out_model_int[], int out_mixers_byt[][VARS_PER_MIXER], int out_channels_byt[][VARS_PER_CHANNEL]);
-		byte Serialize(byte dataset_byt, byte channel_byt);
+		byte CheckBlock(byte dataset_byt);
+		byte FindVar(const char *name_str, VarRef *out_ref);
+		void GetName(byte id_byt, byte number_byt, char *out_name_str);
+		char GetType(byte id_byt);
+		byte IsGlobal(byte id_byt);
+		byte Validate(byte id_byt, int value_int);
+		int GetVar(byte dataset_byt, byte id_byt, byte number_byt = 0);
+		int GetVar(byte dataset_byt, byte id_byt, byte number_byt, char *out_value_str);
+		byte SetVar(byte dataset_byt, byte id_byt, byte number_byt, int value_int, const char *value_str = NULL);
+		byte GetGlobal(GlobalSettings *out_global_obj);
+		byte GetDataset(byte dataset_byt, DatasetSettings *out_dataset_obj);
+		byte BlockSize(byte dataset_byt);
+		byte GetBlock(byte dataset_byt, byte *out_block_byt);
+		byte SetBlock(byte dataset_byt, const byte *block_byt);
+		unsigned int Checksum(const byte *buffer_byt, byte size_byt, unsigned int sums_int = 0);
+		byte SerializeLine(byte dataset_byt, byte channel_byt, int *inout_item_int);
+		byte DiffLine(byte dataset_byt, byte reference_byt, int *inout_item_int);
+		void WriteNext();
+		byte Pending();
+		unsigned long Writes();
+		unsigned long SkippedWrites();
+		void ResetStats();
 };
 #endif
@@ -0,0 +1,86 @@
+/* arduinotx_expo.cpp - Fixed-point exponential curves
+** 16-10-2026 created: replaces the float exp() calls of ComputeChannelPulse()
+
+Copyright (C) 2014-26 Gregor Schlechtriem.  All rights reserved.
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+Contact information: http://www.pikoder.com
+*/
+
+#include "arduinotx_expo.h"
+
+// number of steps of ExpoTable_int[], one step = 1/16
+#define EXPO_TABLE_STEPS 160
+
+// exp(-i/16) for i in [0, EXPO_TABLE_STEPS], 65535 = 1.0
+// i.e. exp(k * (|x| - 1)) sampled every 1/16 for k * (1 - |x|) in [0, 10]
+static const unsigned int ExpoTable_int[EXPO_TABLE_STEPS + 1] PROGMEM = {
+	65535, 61564, 57834, 54330, 51039, 47946, 45042, 42313, 39749, 37341,
+	35078, 32953, 30957, 29081, 27319, 25664, 24109, 22648, 21276, 19987,
+	18776, 17639, 16570, 15566, 14623, 13737, 12905, 12123, 11388, 10698,
+	10050, 9441, 8869, 8332, 7827, 7353, 6907, 6489, 6096, 5726,
+	5379, 5054, 4747, 4460, 4190, 3936, 3697, 3473, 3263, 3065,
+	2879, 2705, 2541, 2387, 2242, 2107, 1979, 1859, 1746, 1641,
+	1541, 1448, 1360, 1278, 1200, 1128, 1059, 995, 935, 878,
+	825, 775, 728, 684, 642, 604, 567, 533, 500, 470,
+	442, 415, 390, 366, 344, 323, 303, 285, 268, 252,
+	236, 222, 209, 196, 184, 173, 162, 153, 143, 135,
+	127, 119, 112, 105, 99, 93, 87, 82, 77, 72,
+	68, 64, 60, 56, 53, 50, 47, 44, 41, 39,
+	36, 34, 32, 30, 28, 27, 25, 23, 22, 21,
+	19, 18, 17, 16, 15, 14, 13, 13, 12, 11,
+	10, 10, 9, 9, 8, 8, 7, 7, 6, 6,
+	6, 5, 5, 5, 4, 4, 4, 4, 3, 3,
+	3
+};
+
+// Return the magnitude of the curve for given magnitude of the input
+// scale_int : see expoScale()
+// magnitude_int : |x| mapped to [0, 1023]
+// Return value: |y| mapped to [0, 1023]
+static unsigned int expo_magnitude(unsigned int scale_int, unsigned int magnitude_int) {
+	// position in ExpoTable_int[], 8 bits integer part + 8 bits fraction
+	unsigned int pos_int = ((unsigned long)(1023 - magnitude_int) * scale_int) >> 8;
+	byte idx_byt = pos_int >> 8;
+	unsigned int exp_int = pgm_read_word(&ExpoTable_int[idx_byt]);
+	if (idx_byt < EXPO_TABLE_STEPS) {
+		// linear interpolation between 2 consecutive table values
+		unsigned int delta_int = exp_int - pgm_read_word(&ExpoTable_int[idx_byt + 1]);
+		exp_int -= ((unsigned long)delta_int * (pos_int & 0xFF)) >> 8;
+	}
+	return ((unsigned long)magnitude_int * exp_int + 32768UL) >> 16;
+}
+
+/*
+** Public -----------------------------------------------------------------
+*/
+
+// Return the scale factor of the curve corresponding to given exponential percentage
+// expo_byt : channel var EXP, [0, 100], 0=linear
+// the scale factor is the number of table steps per unit of (1023 - |x|), in 1/256
+// 16 * (EXP / 10) / 1023 * 256 * 256 ~ EXP * 26239 / 256
+unsigned int expoScale(byte expo_byt) {
+	return ((unsigned long)expo_byt * 26239UL + 128) >> 8;
+}
+
+// Apply the centered symetrical curve
+// scale_int : see expoScale()
+// value_int : [0, 1023], 512 is the center
+// Return value: [0, 1023]
+unsigned int expoSymmetric(unsigned int scale_int, unsigned int value_int) {
+	unsigned int retval_int = 0;
+	if (value_int >= 512)
+		retval_int = 512 + (expo_magnitude(scale_int, 2 * value_int - 1023) >> 1);
+	else
+		retval_int = 512 - ((expo_magnitude(scale_int, 1023 - 2 * value_int) + 1) >> 1);
+	return retval_int;
+}
+
+// Apply the full exponential curve (throttle channel of gas engines)
+// scale_int : see expoScale()
+// value_int : [0, 1023]
+// Return value: [0, 1023]
+unsigned int expoFull(unsigned int scale_int, unsigned int value_int) {
+	return expo_magnitude(scale_int, value_int);
+}
@@ -0,0 +1,21 @@
+/* arduinotx_expo.h - Fixed-point exponential curves
+** 16-10-2026 created: replaces the float exp() calls of ComputeChannelPulse()
+
+Copyright (C) 2014-26 Gregor Schlechtriem.  All rights reserved.
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+Contact information: http://www.pikoder.com
+
+Both curves apply y = x * exp(k * (|x| - 1)) with k = EXP / 10, as the former float code did.
+exp() is read from a PROGMEM table and linearly interpolated, max error is about 1 unit on the [0, 1023] scale.
+*/
+
+#ifndef arduinotx_expo_h
+#define arduinotx_expo_h
+#include <Arduino.h>
+
+unsigned int expoScale(byte expo_byt);
+unsigned int expoSymmetric(unsigned int scale_int, unsigned int value_int);
+unsigned int expoFull(unsigned int scale_int, unsigned int value_int);
+#endif
@@ -0,0 +1,29 @@
+/* arduinotx_hal.h - Hardware abstraction layer
+** 16-10-2026 created
+
+Copyright (C) 2014-26 Gregor Schlechtriem.  All rights reserved.
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+Contact information: http://www.pikoder.com
+
+The modules only use the Arduino core API (Arduino.h, EEPROM.h) and the ATMega 328 registers (avr/io.h, avr/interrupt.h, avr/pgmspace.h).
+On the board these are provided by the Arduino IDE. The host build in directory host/ provides the same headers on Linux,
+backed by a simulated ATMega 328: pots, switches, EEPROM, clock, Timer1, Timer2, ADC and serial ports, see host/hal_host.h.
+ARDUINOTX_HOST is defined by the host build only.
+
+The simulated clock only runs while the firmware calls the Arduino core or halWait():
+a busy loop waiting for an ISR without calling any of them must call halWait() in its body.
+*/
+
+#ifndef arduinotx_hal_h
+#define arduinotx_hal_h
+
+#ifdef ARDUINOTX_HOST
+#include "hal_host.h"
+#define halWait() hostWait()		// let the simulated clock run
+#else
+#define halWait()						// the interrupts run by themselves
+#endif
+
+#endif
@@ -13,50 +13,156 @@ Contact information: http://www.reseau.org/arduinorc/index.php?n=Main.Contact
 ** GS changes: 
 ** 09-10-2015 revised PROGMEM vaiabledefs to latest avr-Compiler (>= 1.6) requirements
 ** 01-11-2016 merged latest version of arduinotx (1.5.5) into arduinodtx
+** 16-10-2026 format() replaces fdevopen() and vfprintf_P(): console output formatted in a stack buffer, new aSprintf()
 */
 
 #include "arduinotx_lib.h"
 
 /*
-** printf() to Serial --------------------------------------------------------
+** Console output --------------------------------------------------------
 **
-** Before using these functions, you must call serialInit() in setup() to redirect stdout to Serial
+** Before using these functions, you must call serialInit() in setup() to open the Serial port
+** The format strings support the conversions printed by the firmware only:
+** %d %u %x %c %s %S (string in program memory) %%, the l modifier (%ld %lu %lx), a width with an optional 0 flag (%02x)
+** The characters are collected in a buffer on the stack and handed to Serial by blocks, usually a whole line
 */
 
-// Open Serial port and redirect stdout to Serial
-// Return value: 0=Ok, >0=error
+// characters formatted on the stack by aPrintf() and its variants before they are handed to Serial
+#define FORMAT_BUFFER 40
+
+// Destination of format(): Serial through Buffer_str[], or the string Buffer_str[]
+typedef struct FormatOutputs {
+	char *Buffer_str;
+	byte Size_byt;
+	byte Length_byt;
+	byte Serial_bool; // true=the buffer is sent to Serial when it is full, false=the string is truncated
+} FormatOutput;
+
+// Open Serial port
+// Return value: 0=Ok
 byte serialInit(long bauds_lng) {
-	byte retval_byt = 0;
 	Serial.begin(bauds_lng);
-	FILE *stream_ptr =  fdevopen(serialWrite, NULL); // see aPrintf() in arduinotx_lib.cpp
-	if (stream_ptr) {
-		stdout = stream_ptr;
-		stderr = stream_ptr;
-		// aPrintfln(PSTR("serialInit(%ld)"), bauds_lng);
+	return 0;
+}
+
+// Read a character of a format string in RAM or in program memory
+static char format_char(const char *fmt_str, byte progmem_bool) {
+	return progmem_bool ? pgm_read_byte(fmt_str) : *fmt_str;
+}
+
+// Append a character to the output, send the buffer to Serial when it is full, or truncate a string
+static void output_char(FormatOutput *out_ptr, char c_chr) {
+	if (out_ptr->Length_byt == out_ptr->Size_byt) {
+		if (!out_ptr->Serial_bool)
+			return;
+		Serial.write((const uint8_t *)out_ptr->Buffer_str, out_ptr->Length_byt);
+		out_ptr->Length_byt = 0;
 	}
-	else {
-		Serial.println("fdevopen failed");
-		retval_byt = 232;
+	out_ptr->Buffer_str[out_ptr->Length_byt++] = c_chr;
+}
+
+// Append a number in base 10 or 16, padded on the left up to width_byt characters
+static void output_number(FormatOutput *out_ptr, unsigned long value_lng, byte negative_bool, byte base_byt, byte width_byt, char pad_chr) {
+	char digits_str[10]; // 4294967295, in reverse order
+	byte count_byt = 0;
+	do {
+		byte digit_byt = value_lng % base_byt;
+		digits_str[count_byt++] = digit_byt < 10 ? '0' + digit_byt : 'a' - 10 + digit_byt;
+		value_lng /= base_byt;
+	} while (value_lng);
+	byte length_byt = count_byt + negative_bool;
+	if (negative_bool && pad_chr == '0')
+		output_char(out_ptr, '-');
+	for (; length_byt < width_byt; length_byt++)
+		output_char(out_ptr, pad_chr);
+	if (negative_bool && pad_chr != '0')
+		output_char(out_ptr, '-');
+	while (count_byt)
+		output_char(out_ptr, digits_str[--count_byt]);
+}
+
+// Append the arguments formatted by given format string, see the supported conversions above
+static void format(FormatOutput *out_ptr, const char *fmt_str, byte progmem_bool, va_list args) {
+	char c_chr;
+	while ((c_chr = format_char(fmt_str++, progmem_bool)) != '\0') {
+		if (c_chr != '%') {
+			output_char(out_ptr, c_chr);
+			continue;
+		}
+		char pad_chr = ' ';
+		byte width_byt = 0;
+		byte long_bool = false;
+		c_chr = format_char(fmt_str++, progmem_bool);
+		if (c_chr == '0') {
+			pad_chr = '0';
+			c_chr = format_char(fmt_str++, progmem_bool);
+		}
+		while (c_chr >= '0' && c_chr <= '9') {
+			width_byt = 10 * width_byt + c_chr - '0';
+			c_chr = format_char(fmt_str++, progmem_bool);
+		}
+		if (c_chr == 'l') {
+			long_bool = true;
+			c_chr = format_char(fmt_str++, progmem_bool);
+		}
+		switch (c_chr) {
+			case 'd': {
+				long value_lng = long_bool ? va_arg(args, long) : va_arg(args, int);
+				output_number(out_ptr, value_lng < 0 ? -(unsigned long)value_lng : value_lng, value_lng < 0, 10, width_byt, pad_chr);
+			}
+			break;
+			case 'u':
+			case 'x': {
+				unsigned long value_lng = long_bool ? va_arg(args, unsigned long) : va_arg(args, unsigned int);
+				output_number(out_ptr, value_lng, false, c_chr == 'x' ? 16 : 10, width_byt, pad_chr);
+			}
+			break;
+			case 'c':
+				output_char(out_ptr, va_arg(args, int));
+			break;
+			case 's':
+			case 'S': {
+				const char *value_str = va_arg(args, const char *);
+				char value_chr;
+				while ((value_chr = format_char(value_str++, c_chr == 'S')) != '\0')
+					output_char(out_ptr, value_chr);
+			}
+			break;
+			case '\0':
+				return; // truncated format string
+			default:
+				output_char(out_ptr, c_chr); // %% and unsupported conversions
+			break;
+		}
 	}
-	return retval_byt;
+}
+
+// Format and send to Serial, append \r\n if eol_bool
+static void serial_format(const char *fmt_str, byte progmem_bool, byte eol_bool, va_list args) {
+	char buffer_str[FORMAT_BUFFER];
+	FormatOutput out_obj = {buffer_str, FORMAT_BUFFER, 0, true};
+	format(&out_obj, fmt_str, progmem_bool, args);
+	if (eol_bool) {
+		output_char(&out_obj, '\r');
+		output_char(&out_obj, '\n');
+	}
+	Serial.write((const uint8_t *)buffer_str, out_obj.Length_byt);
 }
 
 // Send given variable list of args over the serial link using a printf-like format string and append \r\n
 void aprintfln(const char *fmt_str, ... ) {
 	va_list args;
 	va_start (args, fmt_str );
-	vprintf(fmt_str, args);
+	serial_format(fmt_str, false, true, args);
 	va_end (args);
-	puts("\r");
 }
 
 // Send given variable list of args over the serial link using a PSTR printf-like format string and append \r\n
 void aPrintfln(const char *fmt_pstr, ... ) {
 	va_list args;
 	va_start (args, fmt_pstr );
-	vfprintf_P(stdout, fmt_pstr, args);
+	serial_format(fmt_pstr, true, true, args);
 	va_end (args);
-	puts("\r");
 }
 
 
@@ -64,7 +170,7 @@ void aPrintfln(const char *fmt_pstr, ... ) {
 void aprintf(const char *fmt_str, ... ) {
 	va_list args;
 	va_start (args, fmt_str );
-	vprintf(fmt_str, args);
+	serial_format(fmt_str, false, false, args);
 	va_end (args);
 }
 
@@ -72,13 +178,20 @@ void aprintf(const char *fmt_str, ... ) {
 void aPrintf(const char *fmt_str, ... ) {
 	va_list args;
 	va_start (args, fmt_str );
-	vfprintf_P(stdout, fmt_str, args);
+	serial_format(fmt_str, true, false, args);
 	va_end (args);
 }
 
-int serialWrite(char c, FILE *f) {
-    Serial.write(c);
-    return 0;
+// Format given variable list of args into a user-allocated buffer using a PSTR printf-like format string
+// buffersize_int : size of out_buffer_str, at most buffersize_int-1 chars will be written and a \0 will be appended
+char *aSprintf(char *out_buffer_str, byte buffersize_int, const char *fmt_pstr, ... ) {
+	FormatOutput out_obj = {out_buffer_str, (byte)(buffersize_int - 1), 0, false};
+	va_list args;
+	va_start (args, fmt_pstr );
+	format(&out_obj, fmt_pstr, true, args);
+	va_end (args);
+	out_buffer_str[out_obj.Length_byt] = '\0';
+	return out_buffer_str;
 }
 
 /*
@@ -199,8 +312,7 @@ char *TimeString(unsigned long seconds_lng, char *out_buffer_str) {
 	unsigned long m = seconds_lng / 60;
 	unsigned long h = seconds_lng / 3600;
 	m = m - (h * 60);
-	sprintf(out_buffer_str, "%02ld:%02ld:%02ld", h, m, seconds_lng - (m * 60) - (h * 3600));
-	return out_buffer_str;
+	return aSprintf(out_buffer_str, 11, PSTR("%02lu:%02lu:%02lu"), h, m, seconds_lng - (m * 60) - (h * 3600));
 }
 
 byte ishexdigit(char a_chr) {
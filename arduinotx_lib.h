@@ -15,6 +15,7 @@ Contact information: http://www.reseau.org/arduinorc/index.php?n=Main.Contact
 ** GS changes: 
 ** 09-10-2015 revised PROGMEM vaiabledefs to latest avr-Compiler (>= 1.6) requirements
 ** 01-11-2016 merged latest version of arduinotx (1.5.5) into arduinodtx
+** 16-10-2026 aSprintf(), removed serialWrite(): console output without avr-libc stdio
 */
 
 
@@ -22,18 +23,17 @@ Contact information: http://www.reseau.org/arduinorc/index.php?n=Main.Contact
 #define arduinotx_lib_h
 #include <Arduino.h>
 #include <avr/pgmspace.h>
-#include <stdio.h>
 #include <stdarg.h>
 
 #define getProgmemByteArrayValue(array, idx) (pgm_read_byte((array) + (idx)))
 #define getProgmemIntArrayValue(array, idx) (pgm_read_word((array) + (idx)))
 
 byte serialInit(long bauds_lng = 9600L);
+char *aSprintf(char *out_buffer_str, byte buffersize_int, const char *fmt_pstr, ... );
 void aprintfln(const char *fmt_str, ... );
 void aPrintfln(const char *fmt_pstr, ... );
 void aprintf(const char *fmt_str, ... );
 void aPrintf(const char *fmt_str, ... );
-int serialWrite(char c, FILE *f);
 int getProgmemStrpos(PGM_P pgm_str, const char c_chr);
 char *getProgmemStrArrayValue(char *out_buffer_str, PGM_P const *array_str, int idx_int, size_t buffersize_int);
 int findProgmemStrArrayIndex(PGM_P const *array_str, const char *value_str, int nitems_int = 32767);
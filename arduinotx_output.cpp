@@ -0,0 +1,155 @@
+/* arduinotx_output.cpp - Channel output scheduler
+** 16-10-2026 created
+** 16-10-2026 packets encoded by an ArduinotxProtocol, runs of contiguous channels
+** 16-10-2026 bytes per frame statistics: BytesSent(), MaxBytes(), ResetStats()
+
+Copyright (C) 2014-26 Gregor Schlechtriem.  All rights reserved.
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+Contact information: http://www.pikoder.com
+*/
+
+#include "arduinotx_output.h"
+#include "arduinotx_ssc.h"
+#include "arduinodtx_transmitter.h"
+
+/* 
+** Variables allocated in arduinodtx.ino  --------------------------------------------
+*/
+
+// miniSSC transmitter
+extern ArduinotxSsc Ssc_obj;
+
+/*
+** Public -----------------------------------------------------------------
+*/
+
+ArduinotxOutput::ArduinotxOutput(ArduinotxProtocol *protocol_ptr) {
+	Protocol_ptr = protocol_ptr;
+}
+
+// Compute the byte budget of a frame for given baud rate and send all channels in the next frame
+void ArduinotxOutput::Init(unsigned long baudrate_lng) {
+	// 10 bits per byte (8N1), one frame every cUpdateCycle microseconds
+	unsigned long budget_lng = baudrate_lng * (cUpdateCycle / 1000) / 10000UL;
+	Budget_byt = min(budget_lng, (unsigned long)(SSC_QUEUE_SIZE - 1));
+	Pending_int = 0;
+	for (byte chan_byt = 0; chan_byt < CHANNELS; chan_byt++) {
+		Value_int[chan_byt] = 0;
+		Sent_int[chan_byt] = 0;
+		Priority_byt[chan_byt] = OUTPUT_PRIORITY_NORMAL;
+	}
+	ResetStats();
+	Keyframe();
+}
+
+// Set the latest value of given channel, called every frame by callback() for each channel before Send()
+// pulse_int : quarter microseconds
+void ArduinotxOutput::Update(byte chan_byt, unsigned int pulse_int, byte priority_byt) {
+	unsigned int value_int = Protocol_ptr->Quantize(pulse_int);
+	Value_int[chan_byt] = value_int;
+	Priority_byt[chan_byt] = priority_byt;
+	unsigned int mask_int = 1 << chan_byt;
+	if (value_int != Sent_int[chan_byt] && !(Pending_int & mask_int)) {
+		Pending_int |= mask_int;
+		Age_byt[chan_byt] = 0;
+	}
+}
+
+// Queue the pending channels that fit in the budget of this frame, called every frame by callback()
+void ArduinotxOutput::Send() {
+	if (--Keyframe_byt == 0)
+		Keyframe();
+	
+	for (byte chan_byt = 0; chan_byt < CHANNELS; chan_byt++) {
+		if ((Pending_int & (1 << chan_byt)) && Age_byt[chan_byt] < 255)
+			Age_byt[chan_byt]++;
+	}
+	
+	// bytes still queued from the previous frames are taken from the budget of this frame
+	byte depth_byt = Ssc_obj.Depth();
+	byte budget_byt = Budget_byt > depth_byt ? Budget_byt - depth_byt : 0;
+	byte sent_byt = 0;
+	byte max_run_byt = Protocol_ptr->MaxRun();
+	while (Pending_int && budget_byt >= Protocol_ptr->PacketBytes(1)) {
+		// extend the run of the chosen channel with its pending neighbours, as long as the packet fits in the budget
+		byte first_byt = next_channel();
+		byte count_byt = 1;
+		while (count_byt < max_run_byt && Protocol_ptr->PacketBytes(count_byt + 1) <= budget_byt) {
+			if (first_byt + count_byt < CHANNELS && is_pending(first_byt + count_byt))
+				count_byt++;
+			else if (first_byt > 0 && is_pending(first_byt - 1)) {
+				first_byt--;
+				count_byt++;
+			}
+			else
+				break;
+		}
+		
+		byte packet_byt[PROTOCOL_MAX_PACKET];
+		byte size_byt = Protocol_ptr->Encode(first_byt, count_byt, Value_int, packet_byt);
+		if (!Ssc_obj.Write(packet_byt, size_byt))
+			break; // queue full, the channels are still pending
+		for (byte chan_byt = first_byt; chan_byt < first_byt + count_byt; chan_byt++) {
+			Sent_int[chan_byt] = Value_int[chan_byt];
+			Pending_int &= ~(1 << chan_byt);
+		}
+		budget_byt -= size_byt;
+		sent_byt += size_byt;
+	}
+	Bytes_lng += sent_byt;
+	MaxBytes_byt = max(MaxBytes_byt, sent_byt);
+}
+
+// Mark all channels as pending, the channels already pending keep their age
+void ArduinotxOutput::Keyframe() {
+	for (byte chan_byt = 0; chan_byt < CHANNELS; chan_byt++) {
+		if (!(Pending_int & (1 << chan_byt))) {
+			Pending_int |= 1 << chan_byt;
+			Age_byt[chan_byt] = 0;
+		}
+	}
+	Keyframe_byt = OUTPUT_KEYFRAME_FRAMES;
+}
+
+// Return the number of bytes queued since last ResetStats()
+// Warning: call with interrupts disabled, the counter is updated by the frame ISR
+unsigned long ArduinotxOutput::BytesSent() {
+	return Bytes_lng;
+}
+
+// Return the highest number of bytes queued in one frame since last ResetStats()
+byte ArduinotxOutput::MaxBytes() {
+	return MaxBytes_byt;
+}
+
+void ArduinotxOutput::ResetStats() {
+	Bytes_lng = 0;
+	MaxBytes_byt = 0;
+}
+
+/*
+** Private -----------------------------------------------------------------
+*/
+
+// Return the pending channel with the highest score, lowest channel first when equal
+// Pending_int must not be 0
+byte ArduinotxOutput::next_channel() {
+	byte retval_byt = 0;
+	int best_score_int = -1;
+	for (byte chan_byt = 0; chan_byt < CHANNELS; chan_byt++) {
+		if (Pending_int & (1 << chan_byt)) {
+			int score_int = Age_byt[chan_byt] + Priority_byt[chan_byt] * OUTPUT_PRIORITY_WEIGHT;
+			if (score_int > best_score_int) {
+				best_score_int = score_int;
+				retval_byt = chan_byt;
+			}
+		}
+	}
+	return retval_byt;
+}
+
+byte ArduinotxOutput::is_pending(byte chan_byt) {
+	return (Pending_int & (1 << chan_byt)) != 0;
+}
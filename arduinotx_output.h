@@ -0,0 +1,64 @@
+/* arduinotx_output.h - Channel output scheduler
+** 16-10-2026 created
+** 16-10-2026 packets encoded by an ArduinotxProtocol, runs of contiguous channels
+
+Copyright (C) 2014-26 Gregor Schlechtriem.  All rights reserved.
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+Contact information: http://www.pikoder.com
+
+The serial link to the SSC carries at most baudrate / 10 bytes per second, i.e. 19 bytes per 20 ms frame at 9600 bauds.
+Each frame, Update() marks the channels whose value changed as pending, then Send() queues as many pending channels
+as the remaining budget of the frame allows, highest score first: score = frames waited + priority * OUTPUT_PRIORITY_WEIGHT.
+A channel that cannot be sent keeps aging, so no channel is starved.
+If the protocol can update several contiguous channels in one packet, the pending neighbours of the chosen channel
+are added to its packet.
+Every OUTPUT_KEYFRAME_FRAMES frames all channels are marked pending, so that a receiver that lost bytes or was 
+power-cycled gets the full state again within a bounded time.
+*/
+
+#ifndef arduinotx_output_h
+#define arduinotx_output_h
+#include <Arduino.h>
+#include "arduinotx_config.h"
+#include "arduinotx_protocol.h"
+
+// Channel priorities
+#define OUTPUT_PRIORITY_LOW 0		// switch or unused channel
+#define OUTPUT_PRIORITY_NORMAL 1	// potentiometer or mixer
+#define OUTPUT_PRIORITY_HIGH 2		// throttle
+
+// Frames waited that are worth one priority level
+#define OUTPUT_PRIORITY_WEIGHT 4
+
+// Period of the full-state keyframe, in frames (50 frames of 20 ms = 1 s)
+#define OUTPUT_KEYFRAME_FRAMES 50
+
+class ArduinotxOutput {
+	private:
+		ArduinotxProtocol *Protocol_ptr;
+		unsigned int Value_int[CHANNELS]; // latest value of each channel, quantized by the protocol
+		unsigned int Sent_int[CHANNELS]; // last value queued for each channel
+		byte Priority_byt[CHANNELS]; // OUTPUT_PRIORITY_*
+		byte Age_byt[CHANNELS]; // frames since the channel is pending, saturates at 255
+		unsigned int Pending_int; // channels waiting to be sent, bit 0 = channel 1
+		byte Budget_byt; // bytes the link can carry per frame
+		byte Keyframe_byt; // frames until next keyframe
+		unsigned long Bytes_lng; // bytes queued since last ResetStats()
+		byte MaxBytes_byt; // most bytes queued in a frame since last ResetStats()
+		
+		byte next_channel();
+		byte is_pending(byte chan_byt);
+
+	public:
+		ArduinotxOutput(ArduinotxProtocol *protocol_ptr);
+		void Init(unsigned long baudrate_lng);
+		void Update(byte chan_byt, unsigned int pulse_int, byte priority_byt);
+		void Send();
+		void Keyframe();
+		unsigned long BytesSent();
+		byte MaxBytes();
+		void ResetStats();
+};
+#endif
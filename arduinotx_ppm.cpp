@@ -0,0 +1,182 @@
+/* arduinotx_ppm.cpp - Frame clock and PPM signal generator on Timer1
+** 16-10-2026 created
+** 16-10-2026 frame statistics: GetStats(), ResetStats()
+
+Copyright (C) 2014-26 Gregor Schlechtriem.  All rights reserved.
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+Contact information: http://www.pikoder.com
+*/
+
+#include "arduinotx_ppm.h"
+#include "arduinodtx_transmitter.h"
+
+// Timer1 ticks per microsecond, prescaler 8
+#define PPM_TICKS_PER_US 2
+
+// number of edges in a PPM sequence: a falling and a rising edge for each channel and for the final sync pulse
+#define PPM_EDGES (2 * CHANNELS + 2)
+
+/* 
+** Variables allocated in arduinodtx.ino  --------------------------------------------
+*/
+
+// Frame clock and PPM generator
+extern ArduinotxPpm Ppm_obj;
+
+ISR(TIMER1_COMPA_vect) {
+	Ppm_obj.Frame();
+}
+
+#ifdef PPM_ENABLED
+ISR(TIMER1_COMPB_vect) {
+	Ppm_obj.Edge();
+}
+#endif
+
+/*
+** Public -----------------------------------------------------------------
+*/
+
+// Start Timer1 and the frame clock
+// callback_ptr : called every cUpdateCycle microseconds by ISR(TIMER1_COMPA_vect)
+// The PPM signal starts with the first call to Set()
+void ArduinotxPpm::Init(void (*callback_ptr)()) {
+	Callback_ptr = callback_ptr;
+	Front_byt = 0;
+	Ready_bool = false;
+	Started_bool = false;
+	Busy_bool = false;
+	ResetStats();
+	Low_int = ArduinoTx::PPM_LOW * PPM_TICKS_PER_US;
+	
+	byte sreg_byt = SREG;
+	cli();
+#ifdef PPM_ENABLED
+	// rest level is high
+	pinMode(ArduinoTx::PPM_PIN, OUTPUT);
+	TCCR1A = _BV(COM1B1) | _BV(COM1B0); // set OC1B on compare match
+	TCCR1C = _BV(FOC1B); // force a compare match
+	TCCR1A = _BV(COM1B1); // next edge is falling
+#else
+	TCCR1A = 0; // normal mode, OC1A and OC1B disconnected
+#endif
+	TCCR1B = _BV(CS11); // prescaler 8
+	OCR1A = TCNT1 + cUpdateCycle * PPM_TICKS_PER_US;
+	TIFR1 = _BV(OCF1A) | _BV(OCF1B);
+	TIMSK1 = _BV(OCIE1A);
+	SREG = sreg_byt;
+}
+
+// Set the pulse widths of the next PPM sequence, called by the frame callback
+// pulses_int : quarter microseconds, for each channel
+void ArduinotxPpm::Set(const unsigned int pulses_int[]) {
+#ifdef PPM_ENABLED
+	unsigned int high_int[CHANNELS];
+	unsigned int sum_int = Low_int; // final sync pulse
+	for (byte chan_byt = 0; chan_byt < CHANNELS; chan_byt++) {
+		unsigned int pulse_int = pulses_int[chan_byt] / (4 / PPM_TICKS_PER_US);
+		pulse_int = max(pulse_int, Low_int + PPM_MIN_HIGH * PPM_TICKS_PER_US);
+		high_int[chan_byt] = pulse_int - Low_int;
+		sum_int += pulse_int;
+	}
+	// the sequence gets longer than PPM_PERIOD if the pulses do not fit
+	unsigned int period_int = ArduinoTx::PPM_PERIOD * PPM_TICKS_PER_US;
+	unsigned int gap_int = PPM_MIN_GAP * PPM_TICKS_PER_US;
+	if (sum_int + gap_int < period_int)
+		gap_int = period_int - sum_int;
+	
+	byte sreg_byt = SREG;
+	cli(); // the ISR must not swap the buffers while the back buffer is written
+	byte back_byt = Front_byt ^ 1;
+	for (byte chan_byt = 0; chan_byt < CHANNELS; chan_byt++)
+		High_int[back_byt][chan_byt] = high_int[chan_byt];
+	Gap_int[back_byt] = gap_int;
+	Ready_bool = true;
+	if (!Started_bool) {
+		// first sequence: first falling edge in 100 microseconds
+		Started_bool = true;
+		Edge_byt = PPM_EDGES - 1;
+		OCR1B = TCNT1 + 100 * PPM_TICKS_PER_US;
+		TIFR1 = _BV(OCF1B);
+		TIMSK1 |= _BV(OCIE1B);
+	}
+	SREG = sreg_byt;
+#endif
+}
+
+// Schedule the next frame and call the frame callback, called by ISR(TIMER1_COMPA_vect)
+// The callback may enable the interrupts: if it is still running at the next frame, that frame is skipped
+void ArduinotxPpm::Frame() {
+	unsigned int start_int = TCNT1;
+	unsigned int latency_int = start_int - OCR1A;
+	OCR1A += cUpdateCycle * PPM_TICKS_PER_US;
+	if (Busy_bool) {
+		Overruns_int++;
+		return;
+	}
+	Busy_bool = true;
+	Callback_ptr();
+	
+	// the callback returns with interrupts disabled
+	unsigned int duration_int = TCNT1 - start_int;
+	Duration_lng += duration_int;
+	MinDuration_int = min(MinDuration_int, duration_int);
+	MaxDuration_int = max(MaxDuration_int, duration_int);
+	if (Frames_lng++) {
+		// the interval between two callbacks differs from the frame period by the difference of their latencies
+		unsigned int jitter_int = latency_int > Latency_int ? latency_int - Latency_int : Latency_int - latency_int;
+		MaxJitter_int = max(MaxJitter_int, jitter_int);
+	}
+	Latency_int = latency_int;
+	Busy_bool = false;
+}
+
+// Copy the frame statistics since last ResetStats()
+void ArduinotxPpm::GetStats(FrameStats *out_stats) {
+	byte sreg_byt = SREG;
+	cli();
+	out_stats->Frames_lng = Frames_lng;
+	out_stats->MinDuration_int = Frames_lng ? MinDuration_int / PPM_TICKS_PER_US : 0;
+	out_stats->AvgDuration_int = Frames_lng ? Duration_lng / Frames_lng / PPM_TICKS_PER_US : 0;
+	out_stats->MaxDuration_int = MaxDuration_int / PPM_TICKS_PER_US;
+	out_stats->Jitter_int = MaxJitter_int / PPM_TICKS_PER_US;
+	out_stats->Overruns_int = Overruns_int;
+	SREG = sreg_byt;
+}
+
+void ArduinotxPpm::ResetStats() {
+	byte sreg_byt = SREG;
+	cli();
+	Frames_lng = 0;
+	Duration_lng = 0;
+	MinDuration_int = 0xFFFF;
+	MaxDuration_int = 0;
+	MaxJitter_int = 0;
+	Overruns_int = 0;
+	SREG = sreg_byt;
+}
+
+// Program the next edge of the PPM signal, called by ISR(TIMER1_COMPB_vect) when an edge has been generated
+void ArduinotxPpm::Edge() {
+	Edge_byt = Edge_byt == PPM_EDGES - 1 ? 0 : Edge_byt + 1; // edge just generated
+	unsigned int interval_int;
+	if (Edge_byt == 0) {
+		// start of a sequence
+		if (Ready_bool) {
+			Front_byt ^= 1;
+			Ready_bool = false;
+		}
+		interval_int = Low_int;
+	}
+	else if ((Edge_byt & 1) == 0)
+		interval_int = Low_int; // falling edge: sync pulse
+	else if (Edge_byt < PPM_EDGES - 1)
+		interval_int = High_int[Front_byt][Edge_byt >> 1]; // rising edge: channel pulse
+	else
+		interval_int = Gap_int[Front_byt]; // end of the final sync pulse
+	OCR1B += interval_int;
+	// odd edges are rising: set OC1B on next compare match, even edges are falling: clear OC1B
+	TCCR1A = (Edge_byt & 1) ? _BV(COM1B1) : _BV(COM1B1) | _BV(COM1B0);
+}
@@ -0,0 +1,68 @@
+/* arduinotx_ppm.h - Frame clock and PPM signal generator on Timer1
+** 16-10-2026 created
+
+Copyright (C) 2014-26 Gregor Schlechtriem.  All rights reserved.
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+Contact information: http://www.pikoder.com
+
+Timer1 runs freely with 0.5 microsecond ticks and replaces the TimerOne library:
+- compare match A calls the frame callback every cUpdateCycle microseconds
+- compare match B generates the PPM signal on pin OC1B (PPM_PIN) if PPM_ENABLED is defined.
+  Each edge is set or cleared by the compare hardware, so the ISR latency does not move the edges;
+  ISR(TIMER1_COMPB_vect) only programs the next edge, at least PPM_LOW microseconds later.
+  The signal is high at rest and each channel starts with a low sync pulse of PPM_LOW microseconds.
+The pulse widths are double-buffered: Set() fills the back buffer, the ISR swaps the buffers at the start of the next PPM sequence.
+Frame() measures each frame with Timer1: duration of the callback, delay between the compare match and the start of the
+callback, frames skipped because the previous callback was still running. See GetStats().
+*/
+
+#ifndef arduinotx_ppm_h
+#define arduinotx_ppm_h
+#include <Arduino.h>
+#include "arduinotx_config.h"
+
+// Shortest high part of a channel pulse and shortest gap at the end of the sequence, microseconds
+#define PPM_MIN_HIGH 100
+#define PPM_MIN_GAP 3000
+
+class ArduinotxPpm {
+	public:
+		// Frame statistics since last ResetStats()
+		typedef struct FrameStatss {
+			unsigned long Frames_lng;		// frames computed
+			unsigned int MinDuration_int;	// duration of the frame callback, microseconds, including the ISRs served meanwhile
+			unsigned int AvgDuration_int;
+			unsigned int MaxDuration_int;
+			unsigned int Jitter_int;		// highest deviation of the interval between two callbacks from cUpdateCycle, microseconds
+			unsigned int Overruns_int;		// frames skipped because the callback of the previous frame was still running
+		} FrameStats;
+		
+	private:
+		void (*Callback_ptr)(); // frame callback
+		unsigned int High_int[2][CHANNELS]; // [buffer][channel], high part of each channel pulse, Timer1 ticks
+		unsigned int Gap_int[2]; // [buffer], high part of the last pulse, up to the end of the sequence, Timer1 ticks
+		volatile byte Front_byt; // buffer read by the ISR
+		volatile byte Ready_bool; // true=the back buffer has been set, swap at the start of next sequence
+		byte Edge_byt; // last edge generated: 0=start of sequence, even=falling, odd=rising
+		unsigned int Low_int; // PPM_LOW, Timer1 ticks
+		byte Started_bool;
+		volatile byte Busy_bool; // true=the frame callback is running
+		unsigned long Frames_lng;
+		unsigned long Duration_lng; // sum of the callback durations, Timer1 ticks
+		unsigned int MinDuration_int; // Timer1 ticks
+		unsigned int MaxDuration_int;
+		unsigned int Latency_int; // Timer1 ticks between the compare match and the start of the callback, previous frame
+		unsigned int MaxJitter_int; // Timer1 ticks
+		unsigned int Overruns_int;
+
+	public:
+		void Init(void (*callback_ptr)());
+		void Set(const unsigned int pulses_int[]);
+		void Frame();
+		void Edge();
+		void GetStats(FrameStats *out_stats);
+		void ResetStats();
+};
+#endif
@@ -0,0 +1,76 @@
+/* arduinotx_protocol.cpp - Output protocols of the serial link to the servo controller
+** 16-10-2026 created
+
+Copyright (C) 2014-26 Gregor Schlechtriem.  All rights reserved.
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+Contact information: http://www.pikoder.com
+*/
+
+#include "arduinotx_protocol.h"
+
+/*
+** miniSSC II -----------------------------------------------------------------
+*/
+
+// Return the position [0, 254] for given pulse
+unsigned int ArduinotxMiniSsc::Quantize(unsigned int pulse_int) {
+	const unsigned int low_int = 4 * SSC_PULSE_MIN;
+	const unsigned int range_int = 4 * (SSC_PULSE_MAX - SSC_PULSE_MIN);
+	pulse_int = constrain(pulse_int, low_int, low_int + range_int);
+	return ((unsigned long)(pulse_int - low_int) * 254UL + range_int / 2) / range_int;
+}
+
+byte ArduinotxMiniSsc::MaxRun() {
+	return 1;
+}
+
+byte ArduinotxMiniSsc::PacketBytes(byte count_byt) {
+	return 3 * count_byt;
+}
+
+byte ArduinotxMiniSsc::Encode(byte first_chan_byt, byte count_byt, const unsigned int values_int[], byte out_packet_byt[]) {
+	out_packet_byt[0] = 0xFF; // synch token
+	out_packet_byt[1] = first_chan_byt;
+	out_packet_byt[2] = values_int[first_chan_byt];
+	return 3;
+}
+
+/*
+** Pololu compact protocol -----------------------------------------------------------------
+*/
+
+// Return the target for given pulse, in quarter microseconds
+unsigned int ArduinotxPololu::Quantize(unsigned int pulse_int) {
+	return min(pulse_int, 16383U);
+}
+
+byte ArduinotxPololu::MaxRun() {
+#ifdef POLOLU_SINGLE_TARGET
+	return 1;
+#else
+	return CHANNELS;
+#endif
+}
+
+byte ArduinotxPololu::PacketBytes(byte count_byt) {
+	return count_byt == 1 ? 4 : 3 + 2 * count_byt;
+}
+
+byte ArduinotxPololu::Encode(byte first_chan_byt, byte count_byt, const unsigned int values_int[], byte out_packet_byt[]) {
+	byte size_byt = 0;
+	if (count_byt == 1) {
+		out_packet_byt[size_byt++] = 0x84; // Set Target
+	}
+	else {
+		out_packet_byt[size_byt++] = 0x9F; // Set Multiple Targets
+		out_packet_byt[size_byt++] = count_byt;
+	}
+	out_packet_byt[size_byt++] = first_chan_byt;
+	for (byte chan_byt = first_chan_byt; chan_byt < first_chan_byt + count_byt; chan_byt++) {
+		out_packet_byt[size_byt++] = values_int[chan_byt] & 0x7F;
+		out_packet_byt[size_byt++] = (values_int[chan_byt] >> 7) & 0x7F;
+	}
+	return size_byt;
+}
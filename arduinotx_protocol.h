@@ -0,0 +1,60 @@
+/* arduinotx_protocol.h - Output protocols of the serial link to the servo controller
+** 16-10-2026 created
+
+Copyright (C) 2014-26 Gregor Schlechtriem.  All rights reserved.
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+Contact information: http://www.pikoder.com
+
+The channel pulses are computed in quarter microseconds; each protocol quantizes them to its own resolution
+and encodes the packets updating a run of contiguous channels.
+The protocol is selected by OUTPUT_PROTOCOL in arduinotx_config.h
+*/
+
+#ifndef arduinotx_protocol_h
+#define arduinotx_protocol_h
+#include <Arduino.h>
+#include "arduinotx_config.h"
+
+// Size of the largest packet: Pololu Set Multiple Targets for all channels
+#define PROTOCOL_MAX_PACKET (3 + 2 * CHANNELS)
+
+class ArduinotxProtocol {
+	public:
+		// Return the value sent for given pulse width, in the resolution of the protocol
+		// pulse_int : quarter microseconds
+		virtual unsigned int Quantize(unsigned int pulse_int) = 0;
+		// Return the highest number of contiguous channels updated by one packet
+		virtual byte MaxRun() = 0;
+		// Return the size of the packet updating count_byt contiguous channels
+		virtual byte PacketBytes(byte count_byt) = 0;
+		// Encode the packet updating channels first_chan_byt to first_chan_byt + count_byt - 1, 0-based
+		// values_int : values returned by Quantize() for all channels
+		// Return value: size of the packet
+		virtual byte Encode(byte first_chan_byt, byte count_byt, const unsigned int values_int[], byte out_packet_byt[]) = 0;
+};
+
+// miniSSC II: 0xFF, channel, position [0, 254]
+// positions 0 and 254 correspond to pulses of SSC_PULSE_MIN and SSC_PULSE_MAX microseconds
+class ArduinotxMiniSsc : public ArduinotxProtocol {
+	public:
+		virtual unsigned int Quantize(unsigned int pulse_int);
+		virtual byte MaxRun();
+		virtual byte PacketBytes(byte count_byt);
+		virtual byte Encode(byte first_chan_byt, byte count_byt, const unsigned int values_int[], byte out_packet_byt[]);
+};
+
+// Pololu Maestro compact protocol, targets in quarter microseconds [0, 16383]
+// Set Target: 0x84, channel, target bits 0-6, target bits 7-13
+// Set Multiple Targets: 0x9F, number of targets, first channel, then 2 bytes per target
+// The Maestro must be configured in "UART, fixed baud rate" mode at the baud rate of global variable SBR
+// Set Multiple Targets is not implemented by the Micro Maestro 6, define POLOLU_SINGLE_TARGET for this controller
+class ArduinotxPololu : public ArduinotxProtocol {
+	public:
+		virtual unsigned int Quantize(unsigned int pulse_int);
+		virtual byte MaxRun();
+		virtual byte PacketBytes(byte count_byt);
+		virtual byte Encode(byte first_chan_byt, byte count_byt, const unsigned int values_int[], byte out_packet_byt[]);
+};
+#endif
@@ -0,0 +1,60 @@
+/* arduinotx_snapshot.cpp - Lock-free snapshot of the channel inputs and outputs of the last frame
+** 16-10-2026 created
+** 16-10-2026 Time_lng
+** 16-10-2026 Pots_int, Switches_byt
+
+Copyright (C) 2014-26 Gregor Schlechtriem.  All rights reserved.
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+Contact information: http://www.pikoder.com
+*/
+
+#include "arduinotx_snapshot.h"
+
+ArduinotxSnapshot::ArduinotxSnapshot() {
+	Sequence_byt = 0;
+	Frames_lng = 0;
+	for (byte copy_byt = 0; copy_byt < 2; copy_byt++)
+		Copies_obj[copy_byt].Frame_lng = 0;
+}
+
+// Publish the values of a frame, called by the frame callback only
+// The counter is odd while copy 0 is written and even while copy 1 is written, Read() uses the other one
+void ArduinotxSnapshot::Publish(const unsigned int pulses_int[], const unsigned int inputs_int[], const unsigned int pots_int[], byte switches_byt) {
+	Frames_lng++;
+	unsigned long time_lng = millis();
+	for (byte copy_byt = 0; copy_byt < 2; copy_byt++) {
+		Sequence_byt++;
+		volatile Snapshot *copy_ptr = &Copies_obj[copy_byt];
+		copy_ptr->Frame_lng = Frames_lng;
+		copy_ptr->Time_lng = time_lng;
+		for (byte chan_byt = 0; chan_byt < CHANNELS; chan_byt++) {
+			copy_ptr->Pulses_int[chan_byt] = pulses_int[chan_byt];
+			copy_ptr->Inputs_int[chan_byt] = inputs_int[chan_byt];
+		}
+		for (byte idx_byt = 0; idx_byt < NPOTS; idx_byt++)
+			copy_ptr->Pots_int[idx_byt] = pots_int[idx_byt];
+		copy_ptr->Switches_byt = switches_byt;
+	}
+}
+
+// Copy the last published snapshot into out_snapshot_obj without waiting for the frame callback
+// Return false if no frame has been published yet
+byte ArduinotxSnapshot::Read(Snapshot *out_snapshot_obj) {
+	byte sequence_byt;
+	do {
+		sequence_byt = Sequence_byt;
+		const volatile Snapshot *copy_ptr = &Copies_obj[sequence_byt & 1];
+		out_snapshot_obj->Frame_lng = copy_ptr->Frame_lng;
+		out_snapshot_obj->Time_lng = copy_ptr->Time_lng;
+		for (byte chan_byt = 0; chan_byt < CHANNELS; chan_byt++) {
+			out_snapshot_obj->Pulses_int[chan_byt] = copy_ptr->Pulses_int[chan_byt];
+			out_snapshot_obj->Inputs_int[chan_byt] = copy_ptr->Inputs_int[chan_byt];
+		}
+		for (byte idx_byt = 0; idx_byt < NPOTS; idx_byt++)
+			out_snapshot_obj->Pots_int[idx_byt] = copy_ptr->Pots_int[idx_byt];
+		out_snapshot_obj->Switches_byt = copy_ptr->Switches_byt;
+	} while (sequence_byt != Sequence_byt);
+	return out_snapshot_obj->Frame_lng != 0;
+}
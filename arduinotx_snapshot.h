@@ -0,0 +1,47 @@
+/* arduinotx_snapshot.h - Lock-free snapshot of the channel inputs and outputs of the last frame
+** 16-10-2026 created
+** 16-10-2026 Time_lng for the telemetry records of STREAM
+** 16-10-2026 Pots_int and Switches_byt: raw inputs of the frame for STREAM
+
+Copyright (C) 2014-26 Gregor Schlechtriem.  All rights reserved.
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+Contact information: http://www.pikoder.com
+
+The frame callback publishes the values of each frame with Publish(), the main loop reads them with Read():
+- the writer never waits for a reader, the reader never waits for the next frame
+- two copies of the snapshot and a sequence counter: Publish() increments the counter before writing each copy,
+  so the copy selected by the low bit of the counter is never the one being written
+- Read() copies the selected snapshot and starts again if the counter has changed meanwhile,
+  which only happens if a frame has been published during the copy
+*/
+
+#ifndef arduinotx_snapshot_h
+#define arduinotx_snapshot_h
+#include <Arduino.h>
+#include "arduinotx_config.h"
+
+class ArduinotxSnapshot {
+	public:
+		// Values of a frame
+		typedef struct Snapshots {
+			unsigned long Frame_lng;			// number of the frame, 0=nothing published yet
+			unsigned long Time_lng;				// millis() when the frame was published
+			unsigned int Pulses_int[CHANNELS];	// channel pulse widths, quarter microseconds
+			unsigned int Inputs_int[CHANNELS];	// input control of each channel [0, 1023], see ArduinoTx::ReadControl()
+			unsigned int Pots_int[NPOTS];		// raw value of each potentiometer [0, 1023]
+			byte Switches_byt;					// state of each switch, bit 0 = switch 1, 1=HIGH
+		} Snapshot;
+
+	private:
+		volatile byte Sequence_byt; // incremented by Publish() before writing each copy
+		volatile Snapshot Copies_obj[2];
+		unsigned long Frames_lng; // frames published, only accessed by Publish()
+
+	public:
+		ArduinotxSnapshot();
+		void Publish(const unsigned int pulses_int[], const unsigned int inputs_int[], const unsigned int pots_int[], byte switches_byt);
+		byte Read(Snapshot *out_snapshot_obj);
+};
+#endif
@@ -0,0 +1,233 @@
+/* arduinotx_ssc.cpp - Buffered miniSSC serial transmitter
+** 16-10-2026 created
+** 16-10-2026 baud rate table, Bench(), bit jitter statistics
+
+Copyright (C) 2014-26 Gregor Schlechtriem.  All rights reserved.
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+Contact information: http://www.pikoder.com
+*/
+
+#include "arduinotx_ssc.h"
+
+/* 
+** Variables allocated in arduinodtx.ino  --------------------------------------------
+*/
+
+// miniSSC transmitter
+extern ArduinotxSsc Ssc_obj;
+
+ISR(TIMER2_COMPA_vect) {
+	Ssc_obj.Transmit();
+}
+
+// Baud rates / 100 that can be selected with global variable SBR
+const unsigned int ArduinotxSsc::Baudrates_int[] PROGMEM = {96, 192, 384, 576, 1152};
+
+/*
+** Public -----------------------------------------------------------------
+*/
+
+// Configure the output pin and Timer2 for given baud rate, the bytes still queued are lost
+// baudrate_lng : 2400 to 115200
+void ArduinotxSsc::Init(byte pin_byt, unsigned long baudrate_lng) {
+	byte sreg_byt = SREG;
+	cli(); // Write() may be called by the frame ISR
+	Pin_byt = pin_byt;
+	Baudrate_lng = baudrate_lng;
+	Muted_bool = false;
+	BytesSent_int = 0;
+	Head_byt = 0;
+	Tail_byt = 0;
+	Busy_bool = false;
+	Bits_byt = 0;
+	ResetStats();
+	
+	Port_reg = portOutputRegister(digitalPinToPort(pin_byt));
+	Mask_byt = digitalPinToBitMask(pin_byt);
+	pinMode(pin_byt, OUTPUT);
+	write_bit(HIGH); // idle line
+	
+	// Timer2 in CTC mode, one compare match per bit
+	// choose the smallest prescaler giving a bit period <= 256 ticks
+	unsigned long ticks_lng = (F_CPU + baudrate_lng / 2) / baudrate_lng; // CPU cycles per bit
+	byte prescaler_byt = _BV(CS20); // 1
+	if (ticks_lng > 256UL * 32UL) {
+		ticks_lng = (ticks_lng + 32) / 64;
+		prescaler_byt = _BV(CS22); // 64
+	}
+	else if (ticks_lng > 256UL * 8UL) {
+		ticks_lng = (ticks_lng + 16) / 32;
+		prescaler_byt = _BV(CS21) | _BV(CS20); // 32
+	}
+	else if (ticks_lng > 256UL) {
+		ticks_lng = (ticks_lng + 4) / 8;
+		prescaler_byt = _BV(CS21); // 8
+	}
+	TIMSK2 = 0;
+	TCCR2A = _BV(WGM21);
+	TCCR2B = prescaler_byt;
+	OCR2A = ticks_lng - 1;
+	SREG = sreg_byt;
+}
+
+// Queue given bytes for transmission, either all of them or none
+// may be called from an ISR
+// Return value: true if the bytes were queued, false if the buffer is full
+byte ArduinotxSsc::Write(const byte data_byt[], byte count_byt) {
+	byte sreg_byt = SREG;
+	cli();
+	byte depth_byt = (Head_byt - Tail_byt) & (SSC_QUEUE_SIZE - 1);
+	if (depth_byt + count_byt >= SSC_QUEUE_SIZE) {
+		// one slot is kept free to tell a full buffer from an empty one
+		if (Overflows_int < 0xFFFF)
+			Overflows_int++;
+		SREG = sreg_byt;
+		return false;
+	}
+	for (byte idx_byt = 0; idx_byt < count_byt; idx_byt++) {
+		Queue_byt[Head_byt] = data_byt[idx_byt];
+		Head_byt = (Head_byt + 1) & (SSC_QUEUE_SIZE - 1);
+	}
+	depth_byt += count_byt;
+	if (depth_byt > MaxDepth_byt)
+		MaxDepth_byt = depth_byt;
+	if (!Busy_bool) {
+		// restart the bit clock
+		Busy_bool = true;
+		TCNT2 = 0;
+		TIFR2 = _BV(OCF2A);
+		TIMSK2 = _BV(OCIE2A);
+		start_byte();
+	}
+	SREG = sreg_byt;
+	return true;
+}
+
+// Return the number of bytes waiting in the buffer
+byte ArduinotxSsc::Depth() {
+	return (Head_byt - Tail_byt) & (SSC_QUEUE_SIZE - 1);
+}
+
+// Return the highest number of bytes queued since last ResetStats()
+byte ArduinotxSsc::MaxDepth() {
+	return MaxDepth_byt;
+}
+
+// Return the number of packets rejected because the buffer was full since last ResetStats()
+unsigned int ArduinotxSsc::Overflows() {
+	byte sreg_byt = SREG;
+	cli();
+	unsigned int retval_int = Overflows_int;
+	SREG = sreg_byt;
+	return retval_int;
+}
+
+// Return the highest delay of a bit edge since last ResetStats(), percentage of the bit period
+// bit edges are delayed by the other ISRs, the receiver may read wrong bits beyond 25 %
+byte ArduinotxSsc::Jitter() {
+	return (MaxLate_byt * 100U) / (OCR2A + 1U);
+}
+
+unsigned long ArduinotxSsc::GetBaudrate() {
+	return Baudrate_lng;
+}
+
+void ArduinotxSsc::ResetStats() {
+	byte sreg_byt = SREG;
+	cli();
+	MaxDepth_byt = 0;
+	MaxLate_byt = 0;
+	Overflows_int = 0;
+	SREG = sreg_byt;
+}
+
+// Measure the throughput, latency and bit jitter at given baud rate, then restore the current baud rate
+// The output pin stays idle during the measure since the SSC would read garbage at another baud rate,
+// the other interrupts keep running and are taken into account.
+// Takes about 250 ms, must not be called from an ISR
+void ArduinotxSsc::Bench(unsigned long baudrate_lng, SscBench *out_bench) {
+	const unsigned long DURATION = 200000UL; // microseconds
+	const byte fill_byt[8] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+	unsigned long current_baudrate_lng = Baudrate_lng;
+	byte sreg_byt = SREG;
+	cli(); // mute before the frame ISR queues a packet at this baud rate
+	Init(Pin_byt, baudrate_lng);
+	Muted_bool = true;
+	SREG = sreg_byt;
+	
+	// latency of a single packet
+	unsigned long start_lng = micros();
+	Write(fill_byt, 3);
+	wait_idle();
+	out_bench->Latency_int = micros() - start_lng;
+	
+	// throughput, the queue is kept full
+	ResetStats();
+	unsigned int sent_int = BytesSent_int;
+	start_lng = micros();
+	while (micros() - start_lng < DURATION) {
+		if (Depth() < SSC_QUEUE_SIZE - 1 - sizeof(fill_byt))
+			Write(fill_byt, sizeof(fill_byt));
+	}
+	cli();
+	sent_int = BytesSent_int - sent_int;
+	SREG = sreg_byt;
+	out_bench->Throughput_lng = (unsigned long)sent_int * (1000000UL / DURATION);
+	out_bench->Jitter_byt = Jitter();
+	wait_idle();
+	
+	Init(Pin_byt, current_baudrate_lng);
+}
+
+// Output next bit, called by ISR(TIMER2_COMPA_vect) at the end of each bit period
+void ArduinotxSsc::Transmit() {
+	// Timer2 was cleared on compare match, so it counts the ticks elapsed since the nominal bit edge
+	byte late_byt = TCNT2;
+	if (late_byt > MaxLate_byt)
+		MaxLate_byt = late_byt;
+	if (Bits_byt > 0) {
+		// data bits then stop bit
+		write_bit(Frame_int & 1);
+		Frame_int >>= 1;
+		Bits_byt--;
+	}
+	else if (Head_byt != Tail_byt) {
+		// stop bit complete, send next byte
+		start_byte();
+	}
+	else {
+		// buffer empty, stop the bit clock
+		TIMSK2 = 0;
+		Busy_bool = false;
+	}
+}
+
+/*
+** Private -----------------------------------------------------------------
+*/
+
+// Output the start bit of next queued byte, interrupts must be disabled
+void ArduinotxSsc::start_byte() {
+	Frame_int = Queue_byt[Tail_byt] | 0x100; // 8 data bits and 1 stop bit
+	Bits_byt = 9;
+	Tail_byt = (Tail_byt + 1) & (SSC_QUEUE_SIZE - 1);
+	BytesSent_int++;
+	write_bit(LOW);
+}
+
+void ArduinotxSsc::write_bit(byte high_bool) {
+	if (Muted_bool)
+		return;
+	if (high_bool)
+		*Port_reg |= Mask_byt;
+	else
+		*Port_reg &= ~Mask_byt;
+}
+
+// Wait until the buffer is empty and the last stop bit is sent, 100 ms max
+void ArduinotxSsc::wait_idle() {
+	unsigned long start_lng = micros();
+	while (Busy_bool && micros() - start_lng < 100000UL) ;
+}
@@ -0,0 +1,72 @@
+/* arduinotx_ssc.h - Buffered miniSSC serial transmitter
+** 16-10-2026 created
+** 16-10-2026 baud rate table, Bench(), bit jitter statistics
+
+Copyright (C) 2014-26 Gregor Schlechtriem.  All rights reserved.
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+Contact information: http://www.pikoder.com
+
+Replaces SoftwareSerial, which disables the interrupts for the whole duration of each byte sent.
+Write() only copies the bytes into a ring buffer; Timer2 interrupts once per bit and ISR(TIMER2_COMPA_vect) 
+shifts the bits out on the output pin, 8N1, LSB first. The timer interrupt is disabled when the buffer is empty.
+Warning: Timer2 cannot be used anymore by other code (e.g. tone() or PWM on pins 3 and 11).
+*/
+
+#ifndef arduinotx_ssc_h
+#define arduinotx_ssc_h
+#include <Arduino.h>
+
+// Number of baud rates that can be selected with global variable SBR, see ArduinotxSsc::Baudrates_int[]
+#define SSC_BAUDRATES 5
+
+// Size of the ring buffer, must be a power of 2 and <= 128
+// one frame of CHANNELS packets of 3 bytes must fit in it
+#define SSC_QUEUE_SIZE 64
+
+class ArduinotxSsc {
+	public:
+		// Results of Bench()
+		typedef struct SscBenchs {
+			unsigned long Throughput_lng;	// bytes per second
+			unsigned int Latency_int;		// microseconds from Write() of a 3 bytes packet to the end of its last stop bit
+			byte Jitter_byt;				// highest delay of a bit edge, percentage of the bit period
+		} SscBench;
+		
+		static const unsigned int Baudrates_int[] PROGMEM; // baud rates / 100 that can be selected with global variable SBR
+
+	private:
+		byte Queue_byt[SSC_QUEUE_SIZE];
+		volatile byte Head_byt; // next byte written by Write()
+		volatile byte Tail_byt; // next byte sent by Transmit()
+		volatile byte Busy_bool; // true while a byte is being shifted out
+		unsigned int Frame_int; // data and stop bits of the byte being sent, LSB first
+		byte Bits_byt; // number of bits left in Frame_int
+		volatile uint8_t *Port_reg; // output register and bit mask of the output pin
+		byte Mask_byt;
+		byte Pin_byt;
+		unsigned long Baudrate_lng;
+		volatile byte Muted_bool; // true=the bits are timed but the output pin stays idle, see Bench()
+		volatile unsigned int BytesSent_int; // number of bytes sent, wraps around
+		volatile byte MaxLate_byt; // highest delay of a bit edge since last ResetStats(), Timer2 ticks
+		volatile byte MaxDepth_byt; // highest number of bytes queued since last ResetStats()
+		volatile unsigned int Overflows_int; // number of packets rejected by Write() since last ResetStats()
+		
+		void start_byte();
+		void write_bit(byte high_bool);
+		void wait_idle();
+
+	public:
+		void Init(byte pin_byt, unsigned long baudrate_lng);
+		byte Write(const byte data_byt[], byte count_byt);
+		byte Depth();
+		byte MaxDepth();
+		unsigned int Overflows();
+		byte Jitter();
+		unsigned long GetBaudrate();
+		void Bench(unsigned long baudrate_lng, SscBench *out_bench);
+		void ResetStats();
+		void Transmit();
+};
+#endif
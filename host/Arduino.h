@@ -0,0 +1,92 @@
+/* Arduino.h - Arduino core API for the host build
+** 16-10-2026 created
+
+Copyright (C) 2014-26 Gregor Schlechtriem.  All rights reserved.
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+Contact information: http://www.pikoder.com
+
+Only the part of the Arduino core used by arduinodtx is provided, implemented by the simulator in hal_host.cpp.
+Pin numbers are the Arduino Nano ones: D0-D7 on PORTD, D8-D13 on PORTB, A0-A5 (14-19) on PORTC, A6 and A7 are analog only.
+*/
+
+#ifndef Arduino_h
+#define Arduino_h
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <math.h>
+#include <avr/pgmspace.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+
+#define A0 14
+#define A1 15
+#define A2 16
+#define A3 17
+#define A4 18
+#define A5 19
+#define A6 20
+#define A7 21
+#define NUM_DIGITAL_PINS 22
+
+#define constrain(amt,low,high) ((amt)<(low)?(low):((amt)>(high)?(high):(amt)))
+#define min(a,b) ((a)<(b)?(a):(b))
+#define max(a,b) ((a)>(b)?(a):(b))
+
+#define noInterrupts() cli()
+#define interrupts() sei()
+
+// Ports
+#define NOT_A_PORT 0
+#define PB 2
+#define PC 3
+#define PD 4
+#define digitalPinToPort(p) ((p) < 8 ? PD : (p) < 14 ? PB : (p) < 20 ? PC : NOT_A_PORT)
+#define digitalPinToBitMask(p) ((uint8_t)(1 << ((p) < 8 ? (p) : (p) < 14 ? (p) - 8 : (p) - 14)))
+#define portOutputRegister(port) ((port) == PD ? &PORTD : (port) == PB ? &PORTB : &PORTC)
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+int analogRead(uint8_t pin);
+
+// every call advances the simulated clock by one microsecond, so that polling loops terminate
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+long map(long x, long in_min, long in_max, long out_min, long out_max);
+
+// Console serial port, backed by stdin and stdout
+class HardwareSerial {
+	public:
+		void begin(unsigned long baud);
+		void end();
+		int available();
+		int read();
+		size_t write(uint8_t c);
+		size_t write(const uint8_t *buffer, size_t size);
+		int availableForWrite();
+		size_t println(const char *s);
+		void flush();
+};
+
+extern HardwareSerial Serial;
+
+#endif
@@ -0,0 +1,26 @@
+/* EEPROM.h - EEPROM library for the host build
+** 16-10-2026 created
+
+Copyright (C) 2014-26 Gregor Schlechtriem.  All rights reserved.
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+Contact information: http://www.pikoder.com
+
+The simulated EEPROM is an array of E2END + 1 bytes, erased (0xFF) or loaded from an image file, see hal_host.h.
+*/
+
+#ifndef EEPROM_h
+#define EEPROM_h
+
+#include <stdint.h>
+
+class EEPROMClass {
+	public:
+		uint8_t read(int address_int);
+		void write(int address_int, uint8_t value_byt);
+};
+
+extern EEPROMClass EEPROM;
+
+#endif
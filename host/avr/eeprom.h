@@ -0,0 +1,23 @@
+/* avr/eeprom.h - avr-libc EEPROM functions for the host build
+** 16-10-2026 created
+
+Copyright (C) 2014-26 Gregor Schlechtriem.  All rights reserved.
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+Contact information: http://www.pikoder.com
+
+The functions access the simulated EEPROM, see hal_host.cpp.
+*/
+
+#ifndef avr_eeprom_h
+#define avr_eeprom_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+uint8_t eeprom_read_byte(const uint8_t *address_ptr);
+void eeprom_read_block(void *out_buffer_ptr, const void *address_ptr, size_t size_int);
+void eeprom_write_byte(uint8_t *address_ptr, uint8_t value_byt);
+
+#endif
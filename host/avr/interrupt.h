@@ -0,0 +1,32 @@
+/* avr/interrupt.h - interrupts for the host build
+** 16-10-2026 created
+
+Copyright (C) 2014-26 Gregor Schlechtriem.  All rights reserved.
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+Contact information: http://www.pikoder.com
+
+An ISR is a plain function called by the simulator when its flag and its enable bit are set and the I bit of SREG is set.
+cli() and sei() clear and set the I bit, sei() runs the pending ISRs at once like the AVR does.
+*/
+
+#ifndef avr_interrupt_h
+#define avr_interrupt_h
+
+#define ISR(vector) extern "C" void vector(void)
+
+extern "C" {
+	void TIMER2_COMPA_vect(void);
+	void TIMER1_COMPA_vect(void);
+	void TIMER1_COMPB_vect(void);
+	void ADC_vect(void);
+	void EE_READY_vect(void);
+}
+
+void hostSei();
+
+#define cli() (SREG &= (uint8_t)~0x80)
+#define sei() hostSei()
+
+#endif
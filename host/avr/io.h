@@ -0,0 +1,152 @@
+/* avr/io.h - ATMega 328 registers for the host build
+** 16-10-2026 created
+
+Copyright (C) 2014-26 Gregor Schlechtriem.  All rights reserved.
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+Contact information: http://www.pikoder.com
+
+Only the registers used by arduinodtx are simulated, see hal_host.cpp.
+Most registers are plain variables read by the simulator between two steps. The others behave like the hardware:
+	TCNT1, TCNT2: running counters, synchronized with the simulated clock when accessed
+	TIFR1, TIFR2: a flag is cleared by writing a logical one to it
+	TCCR1C: writing FOC1B forces a compare match on OC1B
+	EECR: writing EERE reads the EEPROM into EEDR, writing EEPE after EEMPE starts programming EEDR at EEAR
+*/
+
+#ifndef avr_io_h
+#define avr_io_h
+
+#include <stdint.h>
+
+#define F_CPU 16000000UL
+
+#define _BV(bit) (1 << (bit))
+
+// Interrupt flag register: write 1 to clear
+class HostFlagRegister {
+	private:
+		volatile uint8_t Value_byt;
+	public:
+		HostFlagRegister& operator=(uint8_t value_byt) { Value_byt &= (uint8_t)~value_byt; return *this; }
+		HostFlagRegister& operator|=(uint8_t value_byt) { Value_byt = 0; (void)value_byt; return *this; } // read-modify-write clears all the flags that were set
+		operator uint8_t() const { return Value_byt; }
+		void Set(uint8_t mask_byt) { Value_byt |= mask_byt; } // used by the simulator
+		void Clear(uint8_t mask_byt) { Value_byt &= (uint8_t)~mask_byt; }
+};
+
+// Strobe register: the written bits trigger an action, they always read as zero
+class HostStrobeRegister {
+	private:
+		void (*Action_ptr)(uint8_t);
+	public:
+		HostStrobeRegister(void (*action_ptr)(uint8_t)) : Action_ptr(action_ptr) {}
+		HostStrobeRegister& operator=(uint8_t value_byt) { Action_ptr(value_byt); return *this; }
+		operator uint8_t() const { return 0; }
+};
+
+// Control register: each write triggers an action of the simulator, which may change the value
+class HostControlRegister {
+	private:
+		volatile uint8_t Value_byt;
+		void (*Action_ptr)(uint8_t);
+	public:
+		HostControlRegister(void (*action_ptr)(uint8_t)) : Value_byt(0), Action_ptr(action_ptr) {}
+		HostControlRegister& operator=(uint8_t value_byt) { Value_byt = value_byt; Action_ptr(value_byt); return *this; }
+		HostControlRegister& operator|=(uint8_t value_byt) { return *this = Value_byt | value_byt; }
+		HostControlRegister& operator&=(uint8_t value_byt) { return *this = Value_byt & value_byt; }
+		operator uint8_t() const { return Value_byt; }
+		void Set(uint8_t mask_byt) { Value_byt |= mask_byt; } // used by the simulator
+		void Clear(uint8_t mask_byt) { Value_byt &= (uint8_t)~mask_byt; }
+};
+
+#define HOST_REG8(name) extern volatile uint8_t name;
+#define HOST_REG16(name) extern volatile uint16_t name;
+
+HOST_REG8(SREG)
+
+// Ports
+HOST_REG8(PORTB) HOST_REG8(DDRB)
+HOST_REG8(PORTC) HOST_REG8(DDRC)
+HOST_REG8(PORTD) HOST_REG8(DDRD)
+
+// Timer1
+HOST_REG8(TCCR1A) HOST_REG8(TCCR1B) HOST_REG8(TIMSK1)
+HOST_REG16(OCR1A) HOST_REG16(OCR1B) HOST_REG16(ICR1)
+extern HostStrobeRegister TCCR1C;
+extern HostFlagRegister TIFR1;
+volatile uint16_t *hostTcnt1();
+#define TCNT1 (*hostTcnt1())
+
+#define COM1A1 7
+#define COM1A0 6
+#define COM1B1 5
+#define COM1B0 4
+#define WGM11 1
+#define WGM10 0
+#define WGM13 4
+#define WGM12 3
+#define CS12 2
+#define CS11 1
+#define CS10 0
+#define FOC1A 7
+#define FOC1B 6
+#define ICIE1 5
+#define OCIE1B 2
+#define OCIE1A 1
+#define TOIE1 0
+#define ICF1 5
+#define OCF1B 2
+#define OCF1A 1
+#define TOV1 0
+
+// Timer2
+HOST_REG8(TCCR2A) HOST_REG8(TCCR2B) HOST_REG8(TIMSK2) HOST_REG8(OCR2A) HOST_REG8(OCR2B)
+extern HostFlagRegister TIFR2;
+volatile uint8_t *hostTcnt2();
+#define TCNT2 (*hostTcnt2())
+
+#define WGM21 1
+#define WGM20 0
+#define WGM22 3
+#define CS22 2
+#define CS21 1
+#define CS20 0
+#define OCIE2B 2
+#define OCIE2A 1
+#define TOIE2 0
+#define OCF2B 2
+#define OCF2A 1
+#define TOV2 0
+
+// ADC
+HOST_REG8(ADMUX) HOST_REG8(ADCSRA) HOST_REG8(ADCSRB) HOST_REG8(DIDR0)
+HOST_REG16(ADC)
+
+#define REFS1 7
+#define REFS0 6
+#define ADLAR 5
+#define ADEN 7
+#define ADSC 6
+#define ADATE 5
+#define ADIF 4
+#define ADIE 3
+#define ADPS2 2
+#define ADPS1 1
+#define ADPS0 0
+
+// EEPROM
+extern HostControlRegister EECR;
+HOST_REG8(EEDR)
+HOST_REG16(EEAR)
+
+#define EERIE 3
+#define EEMPE 2
+#define EEPE 1
+#define EERE 0
+#define E2END 1023
+
+HOST_REG8(GTCCR)
+
+#endif
@@ -0,0 +1,656 @@
+/* hal_host.cpp - Simulated ATMega 328 board for the host build
+** 16-10-2026 created
+
+Copyright (C) 2014-26 Gregor Schlechtriem.  All rights reserved.
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+Contact information: http://www.pikoder.com
+*/
+
+#define _GNU_SOURCE 1
+#include <Arduino.h>
+#include <EEPROM.h>
+#include <avr/eeprom.h>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+#include "hal_host.h"
+
+// ADC conversion time: 13 ADC clocks, prescaler 128 set by the Arduino core
+#define HOST_ADC_CYCLES (13 * 128)
+
+// interval between two frames of the PPM signal, shorter intervals are channel pulses
+#define HOST_PPM_SYNC_US 2500
+
+// PPM output pin OC1B: D10 = PB2
+#define HOST_OC1B_PIN 10
+
+// EEPROM programming time: erase and write, 3.4 ms
+#define HOST_EEPROM_CYCLES (3400UL * HOST_CYCLES_PER_US)
+
+#define HOST_NO_EVENT (~0ULL)
+
+static void force_compare(uint8_t value_byt);
+static void eeprom_control(uint8_t value_byt);
+
+/*
+** Registers -----------------------------------------------------------------
+*/
+
+volatile uint8_t SREG;
+volatile uint8_t PORTB, DDRB, PORTC, DDRC, PORTD, DDRD;
+volatile uint8_t TCCR1A, TCCR1B, TIMSK1;
+volatile uint16_t OCR1A, OCR1B, ICR1;
+HostStrobeRegister TCCR1C(force_compare);
+HostFlagRegister TIFR1;
+volatile uint8_t TCCR2A, TCCR2B, TIMSK2, OCR2A, OCR2B;
+HostFlagRegister TIFR2;
+volatile uint8_t ADMUX, ADCSRA = _BV(ADEN) | _BV(ADPS2) | _BV(ADPS1) | _BV(ADPS0), ADCSRB, DIDR0; // ADC enabled by the Arduino core
+volatile uint16_t ADC;
+HostControlRegister EECR(eeprom_control);
+volatile uint8_t EEDR;
+volatile uint16_t EEAR;
+volatile uint8_t GTCCR;
+
+/*
+** Simulator state -----------------------------------------------------------------
+*/
+
+static unsigned long long Cycles_lng = 0;
+
+// Timer counters: value of the counter at cycle *Stamp_lng, prescaler used since then
+static volatile uint16_t Tcnt1_int = 0;
+static unsigned long long T1Stamp_lng = 0;
+static unsigned int T1Prescaler_int = 0;
+static volatile uint8_t Tcnt2_byt = 0;
+static unsigned long long T2Stamp_lng = 0;
+static unsigned int T2Prescaler_int = 0;
+
+static uint8_t Oc1b_byt = HIGH; // level of the OC1B output
+
+static unsigned long long AdcEnd_lng = HOST_NO_EVENT; // end of the current conversion
+static uint8_t AdcMux_byt = 0;
+static unsigned int Analog_int[8] = {512, 512, 512, 512, 512, 512, 512, 512};
+static int PinLevel_int[NUM_DIGITAL_PINS]; // level driven on each pin, -1 = not driven
+
+static uint8_t Eeprom_byt[E2END + 1];
+static unsigned long long EepromEnd_lng = HOST_NO_EVENT; // end of the current programming
+static uint16_t EepromAddress_int;
+static uint8_t EepromData_byt;
+static unsigned long EepromWrites_lng = 0;
+
+static unsigned long Frames_lng = 0;
+
+// Console
+static FILE *Console_ptr = NULL; // stdout
+static char ConsoleIn_str[256];
+static int ConsoleInLen_int = 0, ConsoleInPos_int = 0;
+static bool ConsoleEof_bool = false;
+static bool ConsoleOpen_bool = false; // stdin is read between Serial.begin() and Serial.end() only
+
+// Trace
+static FILE *Trace_ptr = NULL;
+static uint8_t TxPin_byt = 0;
+static int RxBit_int = -1; // -1 = waiting for a start bit, 0-7 = data bit, 8 = stop bit
+static uint8_t RxByte_byt;
+static uint8_t SscBytes_byt[256];
+static unsigned int SscCount_int = 0;
+static unsigned long long PpmFall_lng = 0;
+static unsigned int PpmPulses_int[32];
+static uint8_t PpmCount_byt = 0;
+static unsigned int PpmFrame_int[32];
+static uint8_t PpmFrameCount_byt = 0;
+
+// Profile
+static bool Profile_bool = false;
+static double FrameTime_dbl = 0;
+static unsigned long ProfiledFrames_lng = 0;
+
+/*
+** Vectors not defined by the firmware -----------------------------------------------------------------
+*/
+
+extern "C" {
+	__attribute__((weak)) void TIMER2_COMPA_vect(void) {}
+	__attribute__((weak)) void TIMER1_COMPA_vect(void) {}
+	__attribute__((weak)) void TIMER1_COMPB_vect(void) {}
+	__attribute__((weak)) void ADC_vect(void) {}
+	__attribute__((weak)) void EE_READY_vect(void) {}
+}
+
+/*
+** Timers -----------------------------------------------------------------
+*/
+
+static unsigned int timer1_prescaler() {
+	static const unsigned int Prescalers_int[8] = {0, 1, 8, 64, 256, 1024, 0, 0};
+	return Prescalers_int[TCCR1B & 0x07];
+}
+
+static unsigned int timer2_prescaler() {
+	static const unsigned int Prescalers_int[8] = {0, 1, 8, 32, 64, 128, 256, 1024};
+	return Prescalers_int[TCCR2B & 0x07];
+}
+
+// Timer2 counts from 0 to OCR2A in CTC mode, 0 to 255 in normal mode
+static unsigned int timer2_top() {
+	return (TCCR2A & _BV(WGM21)) ? OCR2A : 255;
+}
+
+// Bring the counters up to date with the clock
+static void sync_timers() {
+	if (T1Prescaler_int) {
+		unsigned long long ticks_lng = (Cycles_lng - T1Stamp_lng) / T1Prescaler_int;
+		Tcnt1_int += (uint16_t)ticks_lng;
+		T1Stamp_lng += ticks_lng * T1Prescaler_int;
+	}
+	else
+		T1Stamp_lng = Cycles_lng;
+	T1Prescaler_int = timer1_prescaler();
+
+	if (T2Prescaler_int) {
+		unsigned long long ticks_lng = (Cycles_lng - T2Stamp_lng) / T2Prescaler_int;
+		unsigned int top_int = timer2_top();
+		unsigned int tcnt_int = Tcnt2_byt;
+		if (tcnt_int > top_int && ticks_lng) {
+			// counter written beyond TOP: it runs up to 255 and wraps to 0
+			unsigned int wrap_int = 256 - tcnt_int;
+			tcnt_int = ticks_lng < wrap_int ? tcnt_int + ticks_lng : (ticks_lng - wrap_int) % (top_int + 1);
+		}
+		else if (ticks_lng)
+			tcnt_int = (tcnt_int + ticks_lng) % (top_int + 1);
+		Tcnt2_byt = tcnt_int;
+		T2Stamp_lng += ticks_lng * T2Prescaler_int;
+	}
+	else
+		T2Stamp_lng = Cycles_lng;
+	T2Prescaler_int = timer2_prescaler();
+}
+
+volatile uint16_t *hostTcnt1() {
+	sync_timers();
+	return &Tcnt1_int;
+}
+
+volatile uint8_t *hostTcnt2() {
+	sync_timers();
+	return &Tcnt2_byt;
+}
+
+// Cycle of the next compare match of Timer1 with given value
+static unsigned long long timer1_match(uint16_t ocr_int) {
+	if (T1Prescaler_int == 0)
+		return HOST_NO_EVENT;
+	unsigned long ticks_lng = (uint16_t)(ocr_int - Tcnt1_int);
+	if (ticks_lng == 0)
+		ticks_lng = 65536; // match of the current tick already processed
+	return T1Stamp_lng + ticks_lng * T1Prescaler_int;
+}
+
+// Cycle of the next compare match A of Timer2: the flag is set when the counter is cleared
+static unsigned long long timer2_match() {
+	if (T2Prescaler_int == 0 || !(TCCR2A & _BV(WGM21)))
+		return HOST_NO_EVENT;
+	unsigned int top_int = timer2_top();
+	unsigned long ticks_lng = Tcnt2_byt > top_int ? 256 - Tcnt2_byt + top_int + 1 : top_int + 1 - Tcnt2_byt;
+	return T2Stamp_lng + ticks_lng * T2Prescaler_int;
+}
+
+// Apply the compare output mode of OC1B
+static void compare_output_b() {
+	uint8_t previous_byt = Oc1b_byt;
+	switch ((TCCR1A >> COM1B0) & 0x03) {
+		case 1: Oc1b_byt ^= 1; break;
+		case 2: Oc1b_byt = LOW; break;
+		case 3: Oc1b_byt = HIGH; break;
+		default: return; // OC1B disconnected
+	}
+	if (Trace_ptr && previous_byt == HIGH && Oc1b_byt == LOW) {
+		// falling edge: start of a channel pulse or of the final sync pulse
+		unsigned long us_lng = (Cycles_lng - PpmFall_lng) / HOST_CYCLES_PER_US;
+		PpmFall_lng = Cycles_lng;
+		if (us_lng > HOST_PPM_SYNC_US) {
+			for (PpmFrameCount_byt = 0; PpmFrameCount_byt < PpmCount_byt; PpmFrameCount_byt++)
+				PpmFrame_int[PpmFrameCount_byt] = PpmPulses_int[PpmFrameCount_byt];
+			PpmCount_byt = 0;
+		}
+		else if (PpmCount_byt < 32)
+			PpmPulses_int[PpmCount_byt++] = us_lng;
+	}
+}
+
+static void force_compare(uint8_t value_byt) {
+	if (value_byt & _BV(FOC1B))
+		compare_output_b();
+}
+
+/*
+** Interrupts -----------------------------------------------------------------
+*/
+
+// Receive the bit sent on the SSC transmit pin, sampled at each bit clock before the ISR sends the next one
+static void receive_bit() {
+	uint8_t level_byt = digitalRead(TxPin_byt);
+	if (RxBit_int < 0) {
+		if (level_byt == LOW)
+			RxBit_int = 0; // start bit
+	}
+	else if (RxBit_int < 8) {
+		RxByte_byt = (RxByte_byt >> 1) | (level_byt << 7);
+		RxBit_int++;
+	}
+	else {
+		if (level_byt == HIGH && SscCount_int < sizeof(SscBytes_byt))
+			SscBytes_byt[SscCount_int++] = RxByte_byt; // otherwise framing error
+		RxBit_int = -1;
+	}
+}
+
+// Print the bytes and pulses of the previous frame
+static void trace_frame() {
+	fprintf(Trace_ptr, "%lu SSC", Frames_lng);
+	for (unsigned int idx_int = 0; idx_int < SscCount_int; idx_int++)
+		fprintf(Trace_ptr, " %02X", SscBytes_byt[idx_int]);
+	fputs(" PPM", Trace_ptr);
+	for (uint8_t idx_byt = 0; idx_byt < PpmFrameCount_byt; idx_byt++)
+		fprintf(Trace_ptr, " %u", PpmFrame_int[idx_byt]);
+	fputc('\n', Trace_ptr);
+	SscCount_int = 0;
+}
+
+static void call_vector(void (*vector_ptr)(void)) {
+	uint8_t sreg_byt = SREG;
+	SREG &= (uint8_t)~0x80;
+	vector_ptr();
+	SREG = sreg_byt | 0x80; // reti
+}
+
+// Call the pending ISRs while the I bit is set, highest priority first
+static void dispatch_interrupts() {
+	while (SREG & 0x80) {
+		if ((TIFR2 & _BV(OCF2A)) && (TIMSK2 & _BV(OCIE2A))) {
+			TIFR2.Clear(_BV(OCF2A));
+			if (Trace_ptr)
+				receive_bit();
+			call_vector(TIMER2_COMPA_vect);
+		}
+		else if ((TIFR1 & _BV(OCF1A)) && (TIMSK1 & _BV(OCIE1A))) {
+			TIFR1.Clear(_BV(OCF1A));
+			if (Trace_ptr && Frames_lng)
+				trace_frame();
+			Frames_lng++;
+			if (Profile_bool) {
+				struct timespec start_obj, end_obj;
+				clock_gettime(CLOCK_MONOTONIC, &start_obj);
+				call_vector(TIMER1_COMPA_vect);
+				clock_gettime(CLOCK_MONOTONIC, &end_obj);
+				FrameTime_dbl += (end_obj.tv_sec - start_obj.tv_sec) + (end_obj.tv_nsec - start_obj.tv_nsec) * 1e-9;
+				ProfiledFrames_lng++;
+			}
+			else
+				call_vector(TIMER1_COMPA_vect);
+		}
+		else if ((TIFR1 & _BV(OCF1B)) && (TIMSK1 & _BV(OCIE1B))) {
+			TIFR1.Clear(_BV(OCF1B));
+			call_vector(TIMER1_COMPB_vect);
+		}
+		else if ((ADCSRA & _BV(ADIF)) && (ADCSRA & _BV(ADIE))) {
+			ADCSRA &= (uint8_t)~_BV(ADIF);
+			call_vector(ADC_vect);
+		}
+		else if ((EECR & _BV(EERIE)) && !(EECR & _BV(EEPE)))
+			call_vector(EE_READY_vect);
+		else
+			break;
+	}
+}
+
+void hostSei() {
+	SREG |= 0x80;
+	dispatch_interrupts();
+}
+
+/*
+** Clock -----------------------------------------------------------------
+*/
+
+// Run the board until given cycle
+static void run_until(unsigned long long target_lng) {
+	while (true) {
+		// a conversion is started by setting ADSC
+		if ((ADCSRA & _BV(ADSC)) && (ADCSRA & _BV(ADEN)) && AdcEnd_lng == HOST_NO_EVENT) {
+			AdcEnd_lng = Cycles_lng + HOST_ADC_CYCLES;
+			AdcMux_byt = ADMUX & 0x07;
+		}
+		dispatch_interrupts();
+
+		sync_timers();
+		unsigned long long t1a_lng = timer1_match(OCR1A);
+		unsigned long long t1b_lng = timer1_match(OCR1B);
+		unsigned long long t2_lng = timer2_match();
+		unsigned long long next_lng = min(min(min(t1a_lng, t1b_lng), min(t2_lng, AdcEnd_lng)), EepromEnd_lng);
+		if (next_lng > target_lng) {
+			if (target_lng > Cycles_lng)
+				Cycles_lng = target_lng;
+			return;
+		}
+		Cycles_lng = next_lng;
+		sync_timers();
+		if (next_lng == t1a_lng)
+			TIFR1.Set(_BV(OCF1A));
+		if (next_lng == t1b_lng) {
+			TIFR1.Set(_BV(OCF1B));
+			compare_output_b();
+		}
+		if (next_lng == t2_lng)
+			TIFR2.Set(_BV(OCF2A));
+		if (next_lng == AdcEnd_lng) {
+			ADC = Analog_int[AdcMux_byt];
+			ADCSRA = (ADCSRA & (uint8_t)~_BV(ADSC)) | _BV(ADIF);
+			AdcEnd_lng = HOST_NO_EVENT;
+		}
+		if (next_lng == EepromEnd_lng) {
+			Eeprom_byt[EepromAddress_int & E2END] = EepromData_byt;
+			EECR.Clear(_BV(EEPE));
+			EepromEnd_lng = HOST_NO_EVENT;
+		}
+	}
+}
+
+void hostAdvance(unsigned long us_lng) {
+	run_until(Cycles_lng + (unsigned long long)us_lng * HOST_CYCLES_PER_US);
+}
+
+void hostWait() {
+	hostAdvance(1);
+}
+
+unsigned long long hostCycles() {
+	return Cycles_lng;
+}
+
+/*
+** Arduino core -----------------------------------------------------------------
+*/
+
+unsigned long millis() {
+	hostAdvance(1);
+	return Cycles_lng / (HOST_CYCLES_PER_US * 1000);
+}
+
+unsigned long micros() {
+	hostAdvance(1);
+	return Cycles_lng / HOST_CYCLES_PER_US;
+}
+
+void delay(unsigned long ms_lng) {
+	hostAdvance(ms_lng * 1000);
+}
+
+void delayMicroseconds(unsigned int us_int) {
+	hostAdvance(us_int);
+}
+
+long map(long x, long in_min, long in_max, long out_min, long out_max) {
+	return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+static volatile uint8_t *pin_register(uint8_t pin_byt, volatile uint8_t *portb_ptr, volatile uint8_t *portc_ptr, volatile uint8_t *portd_ptr) {
+	uint8_t port_byt = digitalPinToPort(pin_byt);
+	return port_byt == PD ? portd_ptr : port_byt == PB ? portb_ptr : port_byt == PC ? portc_ptr : NULL;
+}
+
+void pinMode(uint8_t pin_byt, uint8_t mode_byt) {
+	volatile uint8_t *ddr_ptr = pin_register(pin_byt, &DDRB, &DDRC, &DDRD);
+	volatile uint8_t *port_ptr = pin_register(pin_byt, &PORTB, &PORTC, &PORTD);
+	if (!ddr_ptr)
+		return;
+	uint8_t mask_byt = digitalPinToBitMask(pin_byt);
+	if (mode_byt == OUTPUT)
+		*ddr_ptr |= mask_byt;
+	else {
+		*ddr_ptr &= (uint8_t)~mask_byt;
+		if (mode_byt == INPUT_PULLUP)
+			*port_ptr |= mask_byt;
+		else
+			*port_ptr &= (uint8_t)~mask_byt;
+	}
+}
+
+void digitalWrite(uint8_t pin_byt, uint8_t value_byt) {
+	volatile uint8_t *port_ptr = pin_register(pin_byt, &PORTB, &PORTC, &PORTD);
+	if (!port_ptr)
+		return;
+	if (value_byt == LOW)
+		*port_ptr &= (uint8_t)~digitalPinToBitMask(pin_byt);
+	else
+		*port_ptr |= digitalPinToBitMask(pin_byt);
+}
+
+int digitalRead(uint8_t pin_byt) {
+	volatile uint8_t *port_ptr = pin_register(pin_byt, &PORTB, &PORTC, &PORTD);
+	if (!port_ptr || pin_byt >= NUM_DIGITAL_PINS)
+		return LOW;
+	uint8_t mask_byt = digitalPinToBitMask(pin_byt);
+	uint8_t output_bool = *pin_register(pin_byt, &DDRB, &DDRC, &DDRD) & mask_byt;
+	if (output_bool && pin_byt == HOST_OC1B_PIN && (TCCR1A & (_BV(COM1B1) | _BV(COM1B0))))
+		return Oc1b_byt;
+	if (output_bool || PinLevel_int[pin_byt] < 0)
+		return (*port_ptr & mask_byt) ? HIGH : LOW; // output level or pull-up
+	return PinLevel_int[pin_byt];
+}
+
+int analogRead(uint8_t pin_byt) {
+	if (pin_byt >= A0)
+		pin_byt -= A0;
+	hostAdvance(HOST_ADC_CYCLES / HOST_CYCLES_PER_US);
+	return Analog_int[pin_byt & 0x07];
+}
+
+/*
+** EEPROM -----------------------------------------------------------------
+*/
+
+EEPROMClass EEPROM;
+
+// EERE reads the EEPROM at once, EEPE starts programming if EEMPE was set by the previous write
+static void eeprom_control(uint8_t value_byt) {
+	if (value_byt & _BV(EERE)) {
+		EECR.Clear(_BV(EERE));
+		if (EepromEnd_lng == HOST_NO_EVENT) // ignored while programming
+			EEDR = Eeprom_byt[EEAR & E2END];
+	}
+	if (value_byt & _BV(EEPE)) {
+		if ((value_byt & _BV(EEMPE)) && EepromEnd_lng == HOST_NO_EVENT) {
+			EepromAddress_int = EEAR;
+			EepromData_byt = EEDR;
+			EepromEnd_lng = Cycles_lng + HOST_EEPROM_CYCLES;
+			EepromWrites_lng++;
+		}
+		else if (EepromEnd_lng == HOST_NO_EVENT)
+			EECR.Clear(_BV(EEPE));
+		EECR.Clear(_BV(EEMPE)); // cleared by the hardware 4 cycles after it is set
+	}
+}
+
+// The avr-libc functions wait for the end of the current programming
+uint8_t eeprom_read_byte(const uint8_t *address_ptr) {
+	while (EECR & _BV(EEPE))
+		hostWait();
+	EEAR = (uintptr_t)address_ptr;
+	EECR |= _BV(EERE);
+	return EEDR;
+}
+
+void eeprom_read_block(void *out_buffer_ptr, const void *address_ptr, size_t size_int) {
+	for (size_t idx_int = 0; idx_int < size_int; idx_int++)
+		((uint8_t *)out_buffer_ptr)[idx_int] = eeprom_read_byte((const uint8_t *)address_ptr + idx_int);
+}
+
+void eeprom_write_byte(uint8_t *address_ptr, uint8_t value_byt) {
+	while (EECR & _BV(EEPE))
+		hostWait();
+	EEAR = (uintptr_t)address_ptr;
+	EEDR = value_byt;
+	EECR |= _BV(EEMPE);
+	EECR |= _BV(EEPE);
+}
+
+uint8_t EEPROMClass::read(int address_int) {
+	return eeprom_read_byte((const uint8_t *)(uintptr_t)address_int);
+}
+
+void EEPROMClass::write(int address_int, uint8_t value_byt) {
+	eeprom_write_byte((uint8_t *)(uintptr_t)address_int, value_byt);
+}
+
+bool hostEepromBusy() {
+	return EECR & (_BV(EEPE) | _BV(EERIE));
+}
+
+unsigned long hostEepromWrites() {
+	return EepromWrites_lng;
+}
+
+bool hostLoadEeprom(const char *filename_str) {
+	memset(Eeprom_byt, 0xFF, sizeof(Eeprom_byt));
+	FILE *file_ptr = fopen(filename_str, "rb");
+	if (!file_ptr)
+		return false;
+	fread(Eeprom_byt, 1, sizeof(Eeprom_byt), file_ptr);
+	fclose(file_ptr);
+	return true;
+}
+
+bool hostSaveEeprom(const char *filename_str) {
+	FILE *file_ptr = fopen(filename_str, "wb");
+	if (!file_ptr)
+		return false;
+	bool retval_bool = fwrite(Eeprom_byt, 1, sizeof(Eeprom_byt), file_ptr) == sizeof(Eeprom_byt);
+	return fclose(file_ptr) == 0 && retval_bool;
+}
+
+/*
+** Console -----------------------------------------------------------------
+*/
+
+HardwareSerial Serial;
+
+void hostInit() {
+	SREG = 0x80; // interrupts enabled by the Arduino core before setup()
+	Console_ptr = stdout;
+	memset(Eeprom_byt, 0xFF, sizeof(Eeprom_byt));
+	for (uint8_t pin_byt = 0; pin_byt < NUM_DIGITAL_PINS; pin_byt++)
+		PinLevel_int[pin_byt] = -1;
+}
+
+// Read the characters available on stdin, if all previous ones have been read
+static void poll_console() {
+	if (ConsoleInPos_int == ConsoleInLen_int && !ConsoleEof_bool) {
+		struct pollfd poll_obj = {STDIN_FILENO, POLLIN, 0};
+		if (poll(&poll_obj, 1, 0) > 0) {
+			hostConsoleFlush(); // answer of the previous command line before the next one is read
+			ssize_t len_int = ::read(STDIN_FILENO, ConsoleIn_str, sizeof(ConsoleIn_str));
+			ConsoleInPos_int = 0;
+			ConsoleInLen_int = len_int > 0 ? len_int : 0;
+			ConsoleEof_bool = len_int <= 0;
+		}
+	}
+}
+
+// The characters sent while Serial is closed are never read
+bool hostConsoleEof() {
+	poll_console();
+	return ConsoleEof_bool && (ConsoleInPos_int == ConsoleInLen_int || !ConsoleOpen_bool);
+}
+
+void hostConsoleFlush() {
+	if (Console_ptr)
+		fflush(Console_ptr);
+}
+
+void HardwareSerial::begin(unsigned long baud_lng) {
+	(void)baud_lng;
+	ConsoleOpen_bool = true;
+}
+
+void HardwareSerial::end() {
+	hostConsoleFlush();
+	ConsoleOpen_bool = false;
+}
+
+int HardwareSerial::available() {
+	if (!ConsoleOpen_bool)
+		return 0;
+	poll_console();
+	return ConsoleInLen_int - ConsoleInPos_int;
+}
+
+int HardwareSerial::read() {
+	if (!available())
+		return -1;
+	return (uint8_t)ConsoleIn_str[ConsoleInPos_int++];
+}
+
+size_t HardwareSerial::write(uint8_t c_byt) {
+	if (Console_ptr)
+		fputc(c_byt, Console_ptr);
+	return 1;
+}
+
+size_t HardwareSerial::write(const uint8_t *buffer_byt, size_t size_int) {
+	if (Console_ptr)
+		fwrite(buffer_byt, 1, size_int, Console_ptr);
+	return size_int;
+}
+
+// stdout never waits, the transmit buffer of the Arduino core (64 bytes) is always empty
+int HardwareSerial::availableForWrite() {
+	return 63;
+}
+
+size_t HardwareSerial::println(const char *s_str) {
+	size_t len_int = strlen(s_str);
+	for (size_t idx_int = 0; idx_int < len_int; idx_int++)
+		write(s_str[idx_int]);
+	write('\r');
+	write('\n');
+	return len_int + 2;
+}
+
+void HardwareSerial::flush() {
+	hostConsoleFlush();
+}
+
+/*
+** Inputs, trace and profile -----------------------------------------------------------------
+*/
+
+void hostSetAnalog(uint8_t channel_byt, unsigned int value_int) {
+	Analog_int[channel_byt & 0x07] = min(value_int, 1023u);
+}
+
+void hostSetPin(uint8_t pin_byt, int level_int) {
+	if (pin_byt < NUM_DIGITAL_PINS)
+		PinLevel_int[pin_byt] = level_int;
+}
+
+unsigned long hostFrames() {
+	return Frames_lng;
+}
+
+void hostTrace(FILE *out_ptr, uint8_t tx_pin_byt) {
+	Trace_ptr = out_ptr;
+	TxPin_byt = tx_pin_byt;
+	RxBit_int = -1;
+	SscCount_int = 0;
+}
+
+void hostProfile(bool enable_bool) {
+	Profile_bool = enable_bool;
+}
+
+double hostFrameTime() {
+	return ProfiledFrames_lng ? FrameTime_dbl / ProfiledFrames_lng : 0;
+}
@@ -0,0 +1,66 @@
+/* hal_host.h - Simulated ATMega 328 board for the host build
+** 16-10-2026 created
+** 16-10-2026 limits of the simulation: integer sizes
+
+Copyright (C) 2014-26 Gregor Schlechtriem.  All rights reserved.
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+Contact information: http://www.pikoder.com
+
+The simulator is event driven: the clock counts CPU cycles (16 MHz) and jumps from one hardware event to the next:
+Timer1 compare matches A and B (OC1B drives the PPM pin), Timer2 compare match A in CTC mode, end of an ADC conversion.
+The firmware code itself takes no simulated time, except millis(), micros(), delay() and halWait() which advance the clock.
+The ISRs run when their flag and enable bit are set and the I bit of SREG is set, highest priority vector first.
+
+Simulated peripherals:
+	pots: raw ADC value of each analog input (channels 0-7), 512 by default
+	switches: level driven on each digital input, open (pull-up) by default
+	EEPROM: E2END + 1 bytes, erased or loaded from an image file; programming a byte takes 3.4 ms
+	console serial port: stdin and stdout
+	serial link to the SSC: the bits sent on the transmit pin are decoded back into bytes for the trace
+
+Limits: the host compiler has a 32-bit int and a 64-bit long, the ATmega328 a 16-bit int and a 32-bit long.
+An overflow of the target arithmetic goes unnoticed on the host: a host run does not verify it.
+The fixed-point arithmetic of the transfer plan uses int32_t and is checked at compile time for both builds,
+see dual_rate() and pulse_width() in arduinodtx_transmitter.cpp.
+*/
+
+#ifndef hal_host_h
+#define hal_host_h
+
+#include <stdio.h>
+#include <stdint.h>
+#include <avr/io.h>
+
+#define HOST_CYCLES_PER_US (F_CPU / 1000000UL)
+
+// Clock
+void hostAdvance(unsigned long us_lng);	// run the simulated board for given microseconds
+void hostWait();						// run the simulated board for one microsecond, see halWait()
+unsigned long long hostCycles();		// CPU cycles since reset
+
+// Inputs
+void hostSetAnalog(uint8_t channel_byt, unsigned int value_int);	// channel: ADC multiplexer channel 0-7, value: [0, 1023]
+void hostSetPin(uint8_t pin_byt, int level_int);	// level: LOW=closed switch, HIGH, -1=not driven
+
+// EEPROM image
+bool hostLoadEeprom(const char *filename_str);
+bool hostSaveEeprom(const char *filename_str);
+bool hostEepromBusy();				// true while a byte is programmed or ISR(EE_READY_vect) is enabled
+unsigned long hostEepromWrites();	// number of bytes programmed
+
+// Board
+void hostInit();	// reset the simulated board, call before setup()
+
+// Console
+bool hostConsoleEof();	// true once stdin is closed and all its characters have been read
+void hostConsoleFlush();
+
+// Statistics, tracing and profiling
+unsigned long hostFrames();		// number of ISR(TIMER1_COMPA_vect) calls
+void hostTrace(FILE *out_ptr, uint8_t tx_pin_byt);	// print the SSC bytes and the PPM pulses of each frame, out_ptr=NULL to stop
+void hostProfile(bool enable_bool);	// measure the wall clock time spent in ISR(TIMER1_COMPA_vect)
+double hostFrameTime();			// average wall clock time spent in ISR(TIMER1_COMPA_vect), seconds
+
+#endif
@@ -0,0 +1,152 @@
+/* main.cpp - Run arduinodtx on the simulated board
+** 16-10-2026 created
+
+Copyright (C) 2014-26 Gregor Schlechtriem.  All rights reserved.
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+Contact information: http://www.pikoder.com
+
+Calls setup(), then loop() and serialEvent() like the Arduino core does, while the simulated board runs the ISRs.
+The console is stdin/stdout, the trace and the statistics are printed to stderr.
+*/
+
+#include <Arduino.h>
+#include <time.h>
+#include <unistd.h>
+#include "hal_host.h"
+#include "arduinodtx_transmitter.h"
+#include "sketch.h"
+
+// simulated time spent in each iteration of loop()
+#define HOST_LOOP_US 100
+
+// simulated time run after the end of the console input, lets the last command complete
+#define HOST_EOF_US 1000000UL
+
+static void usage() {
+	fputs(
+		"usage: arduinodtx [options]\n"
+		"  -f frames     stop after given number of frames (default: at the end of stdin)\n"
+		"  -p chan=value raw value [0, 1023] of analog input chan (0-7, A0-A7), default 512\n"
+		"  -s pin=level  drive digital pin: 0=switch closed, 1=high; undriven pins read their pull-up\n"
+		"  -c            command mode: close the mode switch, same as -s 9=0\n"
+		"  -e file       EEPROM image, loaded at start (erased if missing) and saved at exit\n"
+		"  -t            trace the bytes sent to the SSC and the PPM pulses of each frame\n"
+		"  -l            run the interrupts only, without loop() and serialEvent()\n"
+		"  -r            run in real time\n"
+		"  -b            print performance statistics at exit\n",
+		stderr);
+}
+
+// Parse "n=value", return false if invalid
+static bool parse_assignment(const char *arg_str, int *out_n, int *out_value) {
+	char *end_str;
+	*out_n = strtol(arg_str, &end_str, 10);
+	if (*end_str != '=' || end_str == arg_str)
+		return false;
+	*out_value = strtol(end_str + 1, &end_str, 10);
+	return *end_str == '\0';
+}
+
+static double wall_clock() {
+	struct timespec time_obj;
+	clock_gettime(CLOCK_MONOTONIC, &time_obj);
+	return time_obj.tv_sec + time_obj.tv_nsec * 1e-9;
+}
+
+int main(int argc, char *argv[]) {
+	unsigned long frames_lng = 0;
+	const char *eeprom_str = NULL;
+	bool trace_bool = false, loop_bool = true, realtime_bool = false, bench_bool = false;
+	int opt_int, n_int, value_int;
+
+	hostInit();
+	while ((opt_int = getopt(argc, argv, "f:p:s:ce:tlrbh")) != -1) {
+		switch (opt_int) {
+			case 'f':
+				frames_lng = strtoul(optarg, NULL, 10);
+				break;
+			case 'p':
+				if (!parse_assignment(optarg, &n_int, &value_int)) {
+					usage();
+					return 2;
+				}
+				hostSetAnalog(n_int >= A0 ? n_int - A0 : n_int, value_int);
+				break;
+			case 's':
+				if (!parse_assignment(optarg, &n_int, &value_int)) {
+					usage();
+					return 2;
+				}
+				hostSetPin(n_int, value_int ? HIGH : LOW);
+				break;
+			case 'c':
+				hostSetPin(MODE_SWITCH_PIN, LOW);
+				break;
+			case 'e':
+				eeprom_str = optarg;
+				hostLoadEeprom(eeprom_str);
+				break;
+			case 't':
+				trace_bool = true;
+				break;
+			case 'l':
+				loop_bool = false;
+				break;
+			case 'r':
+				realtime_bool = true;
+				break;
+			case 'b':
+				bench_bool = true;
+				break;
+			default:
+				usage();
+				return 2;
+		}
+	}
+	FILE *report_ptr = stderr; // Serial writes to stdout
+	if (trace_bool)
+		hostTrace(report_ptr, tx_PIN);
+	hostProfile(bench_bool);
+
+	double start_dbl = wall_clock();
+	setup();
+	unsigned long long eof_lng = 0;
+	while (frames_lng ? hostFrames() < frames_lng : eof_lng == 0 || hostCycles() < eof_lng) {
+		if (loop_bool) {
+			loop();
+			if (Serial.available())
+				serialEvent();
+		}
+		hostAdvance(loop_bool ? HOST_LOOP_US : cUpdateCycle);
+		if (!frames_lng && eof_lng == 0 && hostConsoleEof())
+			eof_lng = hostCycles() + HOST_EOF_US * HOST_CYCLES_PER_US;
+		if (realtime_bool) {
+			double ahead_dbl = hostCycles() / (double)F_CPU - (wall_clock() - start_dbl);
+			if (ahead_dbl > 0.001)
+				usleep(ahead_dbl * 1e6);
+		}
+	}
+	double wall_dbl = wall_clock() - start_dbl;
+	hostConsoleFlush();
+
+	// let the firmware complete its queued EEPROM writes
+	while (eeprom_str && hostEepromBusy())
+		hostAdvance(loop_bool ? HOST_LOOP_US : cUpdateCycle);
+
+	if (eeprom_str && !hostSaveEeprom(eeprom_str)) {
+		fprintf(report_ptr, "cannot write %s\n", eeprom_str);
+		return 1;
+	}
+	if (bench_bool) {
+		double simulated_dbl = hostCycles() / (double)F_CPU;
+		fprintf(report_ptr, "frames: %lu\n", hostFrames());
+		fprintf(report_ptr, "simulated time: %.3f s\n", simulated_dbl);
+		fprintf(report_ptr, "wall clock time: %.3f s (%.1f x real time)\n", wall_dbl, wall_dbl > 0 ? simulated_dbl / wall_dbl : 0);
+		fprintf(report_ptr, "frames per second: %.0f\n", wall_dbl > 0 ? hostFrames() / wall_dbl : 0);
+		fprintf(report_ptr, "frame ISR: %.3f us per frame (%.0f frames per second)\n", hostFrameTime() * 1e6, hostFrameTime() > 0 ? 1 / hostFrameTime() : 0);
+		fprintf(report_ptr, "EEPROM writes: %lu\n", hostEepromWrites());
+	}
+	return 0;
+}
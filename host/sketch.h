@@ -0,0 +1,21 @@
+/* sketch.h - Functions of arduinodtx.ino for the host build
+** 16-10-2026 created
+
+Copyright (C) 2014-26 Gregor Schlechtriem.  All rights reserved.
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with this program.  If not, see <http://www.gnu.org/licenses/>.
+Contact information: http://www.pikoder.com
+
+The Arduino IDE generates these prototypes when it turns the sketch into C++, the host build includes this file instead.
+*/
+
+#ifndef sketch_h
+#define sketch_h
+
+void setup();
+void loop();
+void serialEvent();
+void callback();
+
+#endif
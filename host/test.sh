@@ -0,0 +1,103 @@
+#!/bin/sh
+# test.sh - checks of the firmware on the simulated board, run by "make test"
+# 16-10-2026 created
+#
+# Each check runs a command mode session on a new EEPROM image and looks for the expected lines in the console output.
+# Exit status: number of failed checks
+
+cd "$(dirname "$0")" || exit 1
+IMAGE=$(mktemp)
+IMAGE15=$(mktemp)
+trap 'rm -f "$IMAGE" "$IMAGE15"' EXIT
+FAILED=0
+
+# number of datasets of this build, see arduinotx_eeprom.h
+NDATASETS=$(printf '#include "arduinotx_eeprom.h"\nNDATASETS\n' | ${CXX:-g++} -E -P -DARDUINOTX_HOST -I. -I.. -x c++ - | tail -n 1)
+
+# run "input lines" image [options]: run the command mode on given EEPROM image, print the console output without CR
+run() {
+	INPUT=$1
+	EEPROM=$2
+	shift 2
+	printf '%s\n' "$INPUT" | ./arduinodtx -c -e "$EEPROM" "$@" | tr -d '\r'
+}
+
+# session "input lines": run the command mode on a new EEPROM image
+session() {
+	rm -f "$IMAGE"
+	run "INIT
+$1" "$IMAGE"
+}
+
+# expect "description" "output" "line": the output must contain the line
+expect() {
+	if printf '%s\n' "$2" | grep -qxF -- "$3"; then
+		echo "ok: $1"
+	else
+		echo "FAILED: $1, expected \"$3\""
+		FAILED=$((FAILED + 1))
+	fi
+}
+
+# MODEL accepts the dataset numbers [1, NDATASETS] only, the CDS of a rejected number is not written
+OUTPUT=$(session "MODEL 0
+DUMP GLOBAL")
+expect "MODEL 0 rejected" "$OUTPUT" "0: error"
+expect "MODEL 0 keeps CDS" "$OUTPUT" "CDS=1"
+OUTPUT=$(session "MODEL $((NDATASETS + 1))
+DUMP GLOBAL")
+expect "MODEL $((NDATASETS + 1)) rejected" "$OUTPUT" "$((NDATASETS + 1)): error"
+expect "MODEL $((NDATASETS + 1)) keeps CDS" "$OUTPUT" "CDS=1"
+OUTPUT=$(session "MODEL $NDATASETS
+DUMP GLOBAL")
+expect "MODEL $NDATASETS accepted" "$OUTPUT" "MODEL=$NDATASETS"
+expect "MODEL $NDATASETS sets CDS" "$OUTPUT" "CDS=$NDATASETS"
+
+# A VERLIB 15 image is converted at boot: its global variables end before SBR (40 bytes), CDS is stored at offset 2,
+# the datasets follow without checksums, the rest of the EEProm is erased
+OUTPUT=$(session "MODEL 3
+TSC=60
+NAM=PLANE
+SUB2=-20
+P1M1=-50
+MODEL $NDATASETS
+DUA1=30
+MODEL 3")
+USAGE=$(printf '%s\n' "$OUTPUT" | sed -n 's/^EEPROM initialized, \([0-9]*\) bytes$/\1/p')
+{
+	dd if="$IMAGE" bs=1 count=1 2>/dev/null
+	printf '\017\003'
+	dd if="$IMAGE" bs=1 skip=3 count=37 2>/dev/null
+	dd if="$IMAGE" bs=1 skip=42 count=$((USAGE - 42)) 2>/dev/null
+	head -c $((1024 - USAGE + 2)) /dev/zero | tr '\0' '\377'
+} > "$IMAGE15"
+DUMPS="DUMP GLOBAL
+DUMP
+MODEL $NDATASETS
+DUMP"
+EXPECTED=$(run "$DUMPS" "$IMAGE")
+OUTPUT=$(run "$DUMPS" "$IMAGE15")
+if [ "$OUTPUT" = "$EXPECTED" ]; then
+	echo "ok: VERLIB 15 image converted"
+else
+	echo "FAILED: VERLIB 15 image converted"
+	printf '%s\n' "$EXPECTED" > "$IMAGE"
+	printf '%s\n' "$OUTPUT" | diff "$IMAGE" -
+	FAILED=$((FAILED + 1))
+fi
+expect "VERLIB 15 CDS" "$OUTPUT" "CDS=3"
+expect "VERLIB 15 SBR default" "$OUTPUT" "SBR=96"
+expect "VERLIB 15 dataset 3" "$OUTPUT" "NAM=PLANE"
+expect "VERLIB 15 dataset $NDATASETS" "$OUTPUT" "DUA1=30"
+OUTPUT=$(run "" "$IMAGE15")
+expect "VERLIB 15 image saved as VERLIB 17" "$OUTPUT" "EEPROM ok, $USAGE bytes"
+
+# A frame of IMPORT abandoned by the sender is reported after FRAME_TIMEOUT, without waiting for the next byte
+# 500 frames of 20 ms: INIT writes the whole EEProm first
+rm -f "$IMAGE"
+OUTPUT=$(run "INIT
+IMPORT 1" "$IMAGE" -f 500)
+expect "IMPORT abandoned" "$OUTPUT" "IMPORT: error"
+expect "prompt after IMPORT abandoned" "$(printf '%s\n' "$OUTPUT" | tail -n 1)" "1> "
+
+exit $FAILED